@@ -26,20 +26,27 @@
 #include <borealis/core/audio.hpp>
 #include <borealis/core/bind.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/bxml.hpp>
 #include <borealis/core/event.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/frame_context.hpp>
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/input.hpp>
+#include <borealis/core/log_sink.hpp>
 #include <borealis/core/logger.hpp>
 #include <borealis/core/platform.hpp>
+#include <borealis/core/render_thread.hpp>
+#include <borealis/core/shape_cache.hpp>
+#include <borealis/core/spatial_focus.hpp>
 #include <borealis/core/style.hpp>
 #include <borealis/core/task.hpp>
 #include <borealis/core/theme.hpp>
+#include <borealis/core/thread_pool.hpp>
 #include <borealis/core/time.hpp>
 #include <borealis/core/timer.hpp>
 #include <borealis/core/video.hpp>
 #include <borealis/core/view.hpp>
+#include <borealis/core/view_arena.hpp>
 
 //Views
 #include <borealis/views/applet_frame.hpp>
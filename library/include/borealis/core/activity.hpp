@@ -21,10 +21,12 @@
 namespace brls
 {
 
-#define CONTENT_FROM_XML_RES(x) \
-    brls::View* createContentView() override { return brls::View::createFromXMLResource(x); }
-#define CONTENT_FROM_XML_FILE(x) \
-    brls::View* createContentView() override { return brls::View::createFromXMLFile(x); }
+#define CONTENT_FROM_XML_RES(x)                                                              \
+    brls::View* createContentView() override { return brls::View::createFromXMLResource(x); } \
+    brls::BXMLDocument* getContentBXML() override { return brls::BXMLDocument::getCompiledFile(std::string(BRLS_RESOURCES) + "xml/" + x); }
+#define CONTENT_FROM_XML_FILE(x)                                                         \
+    brls::View* createContentView() override { return brls::View::createFromXMLFile(x); } \
+    brls::BXMLDocument* getContentBXML() override { return brls::BXMLDocument::getCompiledFile(x); }
 #define CONTENT_FROM_XML_STR(x) \
     brls::View* createContentView() override { return brls::View::createFromXMLString(x); }
 
@@ -71,6 +73,36 @@ class Activity
      */
     virtual void onContentAvailable() {};
 
+    /**
+     * Returns the compiled XML layout of the content view, if any. When preloaded, an activity
+     * with a compiled layout is inflated one top-level element at a time, instead of
+     * with createContentView() all at once.
+     *
+     * The CONTENT_FROM_XML_FILE and CONTENT_FROM_XML_RES macros override it
+     * to return the compiled file of the XML file, if it exists.
+     */
+    virtual BXMLDocument* getContentBXML();
+
+    /**
+     * Runs the next step of the content creation, in the activity view arena: creating the
+     * content view (or one top-level element of its compiled layout), then laying it out and
+     * calling onContentAvailable().
+     * Returns true once the content is created.
+     *
+     * Called by Application::preloadActivity() to spread the content creation over several frames.
+     */
+    bool prepareStep();
+
+    /**
+     * Creates the content, or finishes creating it. Called when the activity is pushed.
+     */
+    void prepare();
+
+    /**
+     * Returns true if the content is created.
+     */
+    bool isPrepared();
+
     View* getContentView();
 
     /**
@@ -155,8 +187,34 @@ class Activity
 
     void setAlpha(float alpha);
 
+    /**
+     * Enables or disables the view arena of this activity. When enabled, all the views
+     * (and their Yoga nodes) created by createContentView() are allocated in contiguous blocks,
+     * released all at once when the activity is destroyed. See ViewArena.
+     *
+     * Views created by createContentView() must not be moved to another activity,
+     * and views removed from the content view only give their memory back when the activity is destroyed.
+     *
+     * Must be called before pushing the activity. Default is false.
+     */
+    void setViewArenaEnabled(bool enabled);
+
+    /**
+     * Returns the view arena of this activity, or nullptr if disabled.
+     */
+    ViewArena* getViewArena();
+
   private:
     View* contentView = nullptr;
+
+    bool prepared = false;
+
+    // Compiled layout being inflated one top-level element at a time
+    View* pendingContentView = nullptr;
+    BXMLElement pendingElement;
+    unsigned pendingElementIndex = 0;
+
+    ViewArena* viewArena = nullptr;
 };
 
 } // namespace brls
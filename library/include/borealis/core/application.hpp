@@ -26,8 +26,10 @@
 #include <borealis/core/frame_context.hpp>
 #include <borealis/core/logger.hpp>
 #include <borealis/core/platform.hpp>
+#include <borealis/core/render_thread.hpp>
 #include <borealis/core/style.hpp>
 #include <borealis/core/theme.hpp>
+#include <borealis/core/thread_pool.hpp>
 #include <borealis/core/view.hpp>
 #include <borealis/views/label.hpp>
 #include <unordered_map>
@@ -90,6 +92,30 @@ class Application
     static void popActivity(
         TransitionAnimation animation = TransitionAnimation::FADE, std::function<void(void)> cb = [] {});
 
+    /**
+     * Creates the content of the given activity ahead of time, a bit every frame,
+     * so that pushing it later with pushActivity() is instant. The work is done
+     * on the main thread under a time budget to keep the frame rate steady.
+     *
+     * If the activity is pushed before it's done, the rest of the content
+     * is created right away. The activity is still owned by the caller until pushed.
+     */
+    static void preloadActivity(Activity* activity);
+
+    /**
+     * Pushes the given activity once its content is created. Until then,
+     * a loading activity is shown in its place, while the content is created
+     * with the same time budget as preloadActivity().
+     *
+     * The activity is pushed directly if it's already preloaded.
+     */
+    static void pushActivityWhenReady(Activity* activity, TransitionAnimation animation = TransitionAnimation::FADE);
+
+    /**
+     * Stops preloading the given activity, called when the activity is deleted.
+     */
+    static void cancelActivityPreloading(Activity* activity);
+
     /**
      * Gives the focus to the given view
      * or clears the focus if given nullptr.
@@ -122,6 +148,11 @@ class Application
      */
     static int getFont(std::string fontName);
 
+    /**
+     * Returns every loaded font.
+     */
+    static FontStash* getFontStash();
+
     static void notify(std::string text);
 
     static void onControllerButtonPressed(enum ControllerButton button, bool repeating);
@@ -147,6 +178,44 @@ class Application
     static void setCommonFooter(std::string footer);
     static std::string* getCommonFooter();
 
+    /**
+     * Enables or disables signed distance field text rendering.
+     * Glyphs are then rasterized once and scaled to every font size and
+     * window scale instead of being rasterized again for each of them,
+     * at the cost of slightly softer small text.
+     *
+     * Can be called before creating the window. Clears the font atlas.
+     */
+    static void setTextSDFEnabled(bool enabled);
+    static bool isTextSDFEnabled();
+
+    /**
+     * Sets the number of threads tessellating the shapes drawn during
+     * the frame, the main thread included. The views are still drawn on the main
+     * thread, only the tessellation of their shapes happens on the other ones,
+     * at the end of the frame. 0 or 1 tessellates everything on the main thread
+     * while drawing (default).
+     *
+     * Worth enabling for big view trees, for instance 3 on Switch.
+     * Can be called before creating the window.
+     */
+    static void setTessellationThreads(unsigned threads);
+    static unsigned getTessellationThreads();
+
+    /**
+     * Sets the number of frames that can wait for the render thread.
+     * When enabled, the main thread draws the views of the next frame while
+     * a render thread tessellates, submits and presents the previous one.
+     * Each frame adds up to one frame of input latency, the value is clamped to 2.
+     * 0 renders everything on the main thread (default).
+     *
+     * Direct graphics API calls are not allowed from the main thread
+     * when enabled, see VideoContext::resetState().
+     * Can be called before creating the window.
+     */
+    static void setRenderPipelineDepth(unsigned frames);
+    static unsigned getRenderPipelineDepth();
+
     static void setDisplayFramerate(bool enabled);
     static void toggleFramerateDisplay();
 
@@ -199,10 +268,26 @@ class Application
     inline static std::string title;
 
     inline static FontStash fontStash;
+    inline static bool textSDFEnabled = false;
+
+    inline static unsigned tessellationThreads = 0;
+    inline static ThreadPool* tessellationPool = nullptr;
+
+    inline static unsigned renderPipelineDepth = 0;
+    inline static RenderThread* renderThread   = nullptr;
 
     inline static std::vector<Activity*> activitiesStack;
     inline static std::vector<View*> focusStack;
 
+    struct PreloadingActivity
+    {
+        Activity* activity;
+        Activity* placeholder; // shown in its place by pushActivityWhenReady(), nullptr otherwise
+        TransitionAnimation animation;
+    };
+
+    inline static std::vector<PreloadingActivity> preloadingActivities;
+
     inline static unsigned windowWidth, windowHeight;
 
     inline static View* currentFocus;
@@ -225,10 +310,28 @@ class Application
 
     static void navigate(FocusDirection direction);
 
+    /**
+     * Translates analog sticks deflection to focus navigation (left stick)
+     * and continuous scrolling (right stick).
+     */
+    static void processAnalogInputs(ControllerState* state);
+
     static void onWindowSizeChanged();
 
     static void frame();
+    static void preloadActivities();
+    static void replacePlaceholderActivity(Activity* placeholder, Activity* activity, TransitionAnimation animation);
+
+    /**
+     * Registers the global actions of the given activity, which was just put in the
+     * activities stack, lays it out and focuses it if it's on top of the stack.
+     */
+    static void enterActivity(Activity* activity);
+
     static void clear();
+
+    static void updateTessellationPool();
+    static void updateRenderThread();
     static void exit();
 
     /**
@@ -62,6 +62,7 @@ class Box : public View
   public:
     Box(Axis flexDirection);
     Box();
+    ~Box();
 
     void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
     View* getDefaultFocus() override;
@@ -73,7 +74,7 @@ class Box : public View
     void onFocusLost() override;
     void onParentFocusGained(View* focusedView) override;
     void onParentFocusLost(View* focusedView) override;
-    bool applyXMLAttribute(std::string name, std::string value) override;
+    bool applyXMLAttributeValue(const std::string& name, const XMLValue& value) override;
 
     static View* create();
 
@@ -90,9 +91,15 @@ class Box : public View
     virtual void addView(View* view, size_t position);
 
     /**
-     * Removes the given view from the Box. It will be freed.
+     * Removes the given view from the Box. It will be freed, unless
+     * free is false: it can then be added to a Box again later.
      */
-    virtual void removeView(View* view);
+    virtual void removeView(View* view, bool free = true);
+
+    /**
+     * Removes the view at the given position from the Box. It will be freed.
+     */
+    void removeViewAt(size_t position);
 
     /**
      * Sets the padding of the view, aka the internal space to give
@@ -158,6 +165,20 @@ class Box : public View
 
     void setAxis(Axis axis);
 
+    /**
+     * Enables or disables spatial navigation for this Box.
+     *
+     * When enabled, focus is resolved geometrically for the whole subtree: pressing
+     * a direction focuses the nearest focusable view in that direction, instead of
+     * the next sibling along the box axis. Useful for grids made of rows of boxes,
+     * without having to set custom navigation routes.
+     *
+     * Default is false.
+     */
+    void setSpatialNavigation(bool enabled);
+
+    bool hasSpatialNavigation();
+
     std::vector<View*>& getChildren();
 
     /**
@@ -200,8 +221,6 @@ class Box : public View
      */
     virtual void onChildFocusLost(View* directChild, View* focusedView);
 
-    View* getView(std::string id) override;
-
   private:
     Axis axis;
 
@@ -209,6 +228,8 @@ class Box : public View
 
     size_t defaultFocusedIndex = 0;
 
+    SpatialFocusIndex* spatialNavigationIndex = nullptr;
+
     std::unordered_map<std::string, std::pair<std::string, View*>> forwardedAttributes;
 
   protected:
@@ -234,6 +255,29 @@ class Box : public View
      */
     void inflateFromXMLElement(tinyxml2::XMLElement* element);
 
+    /**
+     * Inflates the Box with the root element of the given compiled XML document,
+     * see BXMLDocument::getCompiledString() to inflate from an XML string compiled once.
+     *
+     * The root element MUST be a brls::Box, corresponding to the inflated Box itself. Its
+     * attributes will be applied to the Box.
+     *
+     * Each child node in the root brls::Box will be treated as a view and added
+     * as a child of the Box.
+     */
+    void inflateFromBXML(BXMLDocument* document);
+
+    /**
+     * Inflates the Box with the given compiled XML element.
+     *
+     * The root element MUST be a brls::Box, corresponding to the inflated Box itself. Its
+     * attributes will be applied to the Box.
+     *
+     * Each child node in the root brls::Box will be treated as a view and added
+     * as a child of the Box.
+     */
+    void inflateFromBXMLElement(BXMLElement element);
+
     /**
      * Inflates the Box with the given XML resource.
      *
@@ -246,7 +290,8 @@ class Box : public View
     void inflateFromXMLRes(std::string res);
 
     /**
-     * Inflates the Box with the given XML file path.
+     * Inflates the Box with the given XML file path, or its compiled
+     * ".bxml" file if it exists and is newer.
      *
      * The root element MUST be a brls::Box, corresponding to the inflated Box itself. Its
      * attributes will be applied to the Box.
@@ -263,6 +308,14 @@ class Box : public View
      * to the children of the Box.
      */
     void handleXMLElement(tinyxml2::XMLElement* element) override;
+
+    /**
+     * Handles a child compiled XML element.
+     *
+     * By default, calls createFromBXMLElement() and adds the result
+     * to the children of the Box.
+     */
+    void handleBXMLElement(BXMLElement element) override;
 };
 
 // An empty view that has auto x auto and grow=1.0 to push
@@ -0,0 +1,207 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+#include <stdint.h>
+#include <tinyxml2.h>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace brls
+{
+
+class View;
+
+// Type of an XML attribute value, as deduced from its text
+enum class XMLValueType
+{
+    STRING, // anything else, only valid for string and file path attributes
+    I18N, // "@i18n/"
+    RESOURCE, // "@res/"
+    AUTO, // "auto"
+    FLOAT, // "12", "12px"
+    PERCENTAGE, // "12%"
+    STYLE, // "@style/"
+    COLOR, // "#RRGGBB", "#RRGGBBAA"
+    THEME, // "@theme/"
+    BOOL, // "true", "false"
+    INVALID, // looks like one of the above but cannot be parsed ("12.0.1px")
+};
+
+// An XML attribute value, typed once so that applying it doesn't need to parse text
+struct XMLValue
+{
+    XMLValueType type = XMLValueType::STRING;
+
+    std::string_view raw; // the whole attribute text
+    std::string_view reference; // name without its prefix for I18N, RESOURCE, STYLE and THEME
+
+    float number   = 0.0f; // FLOAT and PERCENTAGE
+    NVGcolor color = {}; // COLOR
+    bool boolean   = false; // BOOL
+};
+
+/**
+ * Deduces the type of the given XML attribute value and parses it, in one pass
+ * and without throwing. The returned value points to the given text.
+ *
+ * Numbers follow the std::stof() rules to stay compatible with existing layouts:
+ * leading spaces and trailing characters are allowed ("12abc" is 12).
+ */
+XMLValue classifyXMLValue(std::string_view text);
+
+class BXMLDocument;
+
+struct BXMLAttribute
+{
+    std::string name;
+    XMLValue value;
+};
+
+// Lightweight handle to an element of a BXMLDocument
+class BXMLElement
+{
+  public:
+    BXMLElement() = default;
+    BXMLElement(BXMLDocument* document, uint32_t index);
+
+    bool isValid();
+
+    std::string_view getName();
+
+    /**
+     * Returns the index of the element name in the document strings,
+     * to index getViewCreators() with.
+     */
+    uint32_t getNameIndex();
+
+    BXMLElement getFirstChild();
+    BXMLElement getNextSibling();
+
+    /**
+     * Returns the attributes of the element, in document order.
+     */
+    const BXMLAttribute* getAttributes();
+    size_t getAttributesCount();
+
+    /**
+     * Returns the attribute with the given name, or nullptr if there is none.
+     */
+    const BXMLAttribute* findAttribute(std::string_view name);
+
+    BXMLDocument* getDocument();
+
+  private:
+    BXMLDocument* document = nullptr;
+    uint32_t index         = 0;
+};
+
+// A compiled XML layout ("BXML"), made of the XML elements with their attribute
+// values typed ahead of time.
+//
+// Layouts are still written in XML: they are either compiled at build time with the
+// bxml_compiler tool, which writes a ".bxml" file next to every ".xml" file, or at
+// runtime for the XML strings embedded in the library views.
+//
+// Format (little endian):
+//   header: magic "BRLSBXML", u32 version, u32 strings count, u32 elements count, u32 attributes count
+//   strings: u32 offset, u32 length for every string, offsets are relative to the blob
+//   elements, depth first: u32 name string, u32 first attribute, u32 attributes count,
+//       u32 first child, u32 next sibling (BXML_NONE if there is none)
+//   attributes: u32 name string, u32 raw value string, u32 type, u32 payload
+//       (float bits, RGBA color, bool or reference string depending on the type)
+//   blob: UTF-8 strings
+class BXMLDocument
+{
+  public:
+    /**
+     * Compiles the given XML element and its children.
+     * Returns nullptr and sets the error string on failure.
+     */
+    static BXMLDocument* compile(tinyxml2::XMLElement* element, std::string* error);
+
+    /**
+     * Loads a compiled document from the given data.
+     * Returns nullptr and sets the error string on failure.
+     */
+    static BXMLDocument* load(std::vector<char> data, std::string* error);
+
+    /**
+     * Loads a compiled document from the given file path.
+     * Returns nullptr and sets the error string on failure.
+     */
+    static BXMLDocument* loadFile(std::string path, std::string* error);
+
+    /**
+     * Returns the serialized document, to be written to a ".bxml" file.
+     */
+    std::vector<char> serialize();
+
+    BXMLElement getRootElement();
+
+    /**
+     * Returns the view creators of the document, indexed by element name index.
+     * They are empty until resolved by the view creation code, so that every
+     * tag is only looked up in the XML views register once per document.
+     */
+    std::vector<std::function<View*(void)>>& getViewCreators();
+
+    /**
+     * Returns the path of the compiled file of the given XML file,
+     * with the ".xml" extension replaced by ".bxml".
+     */
+    static std::string getCompiledPath(std::string xmlPath);
+
+    /**
+     * Returns the compiled document of the given XML file if its ".bxml" file exists
+     * and is up to date, nullptr otherwise. Loaded documents are kept for
+     * the whole lifetime of the app.
+     */
+    static BXMLDocument* getCompiledFile(std::string xmlPath);
+
+    /**
+     * Returns the given XML string compiled, compiling it the first time. Compiled
+     * documents are kept for the whole lifetime of the app, so this is meant for
+     * the XML strings embedded in views code.
+     */
+    static BXMLDocument* getCompiledString(const std::string& xml);
+
+  private:
+    friend class BXMLElement;
+
+    struct Element
+    {
+        uint32_t name;
+        uint32_t firstAttribute;
+        uint32_t attributesCount;
+        uint32_t firstChild;
+        uint32_t nextSibling;
+    };
+
+    std::vector<char> data; // serialized document, strings point into it
+    std::vector<std::string_view> strings;
+    std::vector<Element> elements;
+    std::vector<BXMLAttribute> attributes;
+
+    std::vector<std::function<View*(void)>> viewCreators;
+};
+
+} // namespace brls
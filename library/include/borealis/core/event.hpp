@@ -16,9 +16,10 @@
 
 #pragma once
 
-#include <algorithm>
+#include <stddef.h>
+
 #include <functional>
-#include <list>
+#include <vector>
 
 namespace brls
 {
@@ -32,42 +33,178 @@ namespace brls
 // 4. call fire when you want to fire the events
 //    it wil return true if at least one subscriber exists
 //    for that event
+//
+// The first subscribers are stored inline, in the event itself, since most
+// events only have one or two. Callbacks can subscribe and unsubscribe while
+// the event is firing: unsubscribed callbacks are only removed once the event
+// is done firing, and new ones are only called the next time it fires.
 template <typename... Ts>
 class Event
 {
   public:
     typedef std::function<void(Ts...)> Callback;
-    typedef std::list<Callback> CallbacksList;
-    typedef typename CallbacksList::iterator Subscription;
+    typedef size_t Subscription;
 
     Subscription subscribe(Callback cb);
     void unsubscribe(Subscription subscription);
     bool fire(Ts... args);
 
   private:
-    CallbacksList callbacks;
+    static constexpr size_t INLINE_SUBSCRIBERS = 2;
+
+    struct Entry
+    {
+        Subscription subscription = 0; // 0 once unsubscribed
+        Callback callback;
+    };
+
+    // Subscribers, in subscription order: inline ones first, then the overflowing ones
+    Entry inlineEntries[INLINE_SUBSCRIBERS];
+    size_t inlineCount = 0;
+    std::vector<Entry> overflowEntries;
+
+    // Subscribed while firing, added to the others once done
+    std::vector<Entry> pendingEntries;
+
+    Subscription lastSubscription = 0;
+    unsigned firing               = 0; // > 0 while firing, can be nested
+    bool compactionNeeded         = false;
+
+    size_t size();
+    Entry& at(size_t index);
+    void append(Entry&& entry);
+    void compact();
 };
 
+template <typename... Ts>
+size_t Event<Ts...>::size()
+{
+    return this->inlineCount + this->overflowEntries.size();
+}
+
+template <typename... Ts>
+typename Event<Ts...>::Entry& Event<Ts...>::at(size_t index)
+{
+    if (index < INLINE_SUBSCRIBERS)
+        return this->inlineEntries[index];
+
+    return this->overflowEntries[index - INLINE_SUBSCRIBERS];
+}
+
+template <typename... Ts>
+void Event<Ts...>::append(Event<Ts...>::Entry&& entry)
+{
+    if (this->inlineCount < INLINE_SUBSCRIBERS)
+        this->inlineEntries[this->inlineCount++] = std::move(entry);
+    else
+        this->overflowEntries.push_back(std::move(entry));
+}
+
+template <typename... Ts>
+void Event<Ts...>::compact()
+{
+    // Move the remaining subscribers down, keeping their order
+    size_t count = this->size();
+    size_t kept  = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Entry& entry = this->at(i);
+
+        if (entry.subscription == 0)
+            continue;
+
+        if (kept != i)
+            this->at(kept) = std::move(entry);
+
+        kept++;
+    }
+
+    for (size_t i = kept; i < count && i < INLINE_SUBSCRIBERS; i++)
+        this->inlineEntries[i] = Entry();
+
+    this->inlineCount = kept < INLINE_SUBSCRIBERS ? kept : INLINE_SUBSCRIBERS;
+    this->overflowEntries.resize(kept > INLINE_SUBSCRIBERS ? kept - INLINE_SUBSCRIBERS : 0);
+
+    this->compactionNeeded = false;
+}
+
 template <typename... Ts>
 typename Event<Ts...>::Subscription Event<Ts...>::subscribe(Event<Ts...>::Callback cb)
 {
-    this->callbacks.push_back(cb);
-    return --this->callbacks.end();
+    Entry entry;
+    entry.subscription = ++this->lastSubscription;
+    entry.callback     = std::move(cb);
+
+    // Don't move the entries around while they are being called
+    if (this->firing > 0)
+        this->pendingEntries.push_back(std::move(entry));
+    else
+        this->append(std::move(entry));
+
+    return this->lastSubscription;
 }
 
 template <typename... Ts>
 void Event<Ts...>::unsubscribe(Event<Ts...>::Subscription subscription)
 {
-    this->callbacks.erase(subscription);
+    for (auto it = this->pendingEntries.begin(); it != this->pendingEntries.end(); ++it)
+    {
+        if (it->subscription == subscription)
+        {
+            this->pendingEntries.erase(it);
+            return;
+        }
+    }
+
+    size_t count = this->size();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Entry& entry = this->at(i);
+
+        if (entry.subscription != subscription)
+            continue;
+
+        // The callback may be the one being called, so only destroy it once done firing
+        entry.subscription = 0;
+
+        if (this->firing > 0)
+            this->compactionNeeded = true;
+        else
+            this->compact();
+
+        return;
+    }
 }
 
 template <typename... Ts>
 bool Event<Ts...>::fire(Ts... args)
 {
-    for (Callback cb : this->callbacks)
-        cb(args...);
+    this->firing++;
+
+    size_t count = this->size();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Entry& entry = this->at(i);
+
+        if (entry.subscription != 0)
+            entry.callback(args...);
+    }
+
+    if (--this->firing == 0)
+    {
+        if (this->compactionNeeded)
+            this->compact();
+
+        for (Entry& entry : this->pendingEntries)
+            this->append(std::move(entry));
+
+        this->pendingEntries.clear();
+    }
 
-    return !this->callbacks.empty();
+    return this->size() > 0;
 }
 
 }; // namespace brls
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <deque>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace brls
 {
@@ -45,6 +47,31 @@ class FontLoader
      */
     virtual void loadFonts() = 0;
 
+    /**
+     * Sets the path of the glyph cache file, or an empty string
+     * to disable the glyph cache (default). Must be called before Application::init().
+     *
+     * The glyph cache holds the glyphs rasterized during the previous run
+     * (bitmaps and metrics) so that they don't have to be rasterized again
+     * the first time a text is drawn. It is loaded after loadFonts() and
+     * saved when the application exits.
+     */
+    static void setGlyphCachePath(std::string path);
+    static std::string getGlyphCachePath();
+
+    /**
+     * Loads the glyph cache file in the font atlas, if enabled.
+     * Glyphs of fonts that changed since the cache was written are ignored.
+     * Returns true if the cache was loaded.
+     */
+    static bool loadGlyphCache();
+
+    /**
+     * Writes every rasterized glyph of the font atlas to the glyph cache file, if enabled.
+     * Returns true if the cache was written.
+     */
+    static bool saveGlyphCache();
+
   protected:
     /**
      * Convenience method to load a font from a file path
@@ -57,6 +84,51 @@ class FontLoader
      * Returns true if the operation succeeds.
      */
     bool loadMaterialFromResources();
+
+  private:
+    inline static std::string glyphCachePath = "";
+};
+
+// Rasterizes glyphs in the font atlas ahead of time, so that drawing
+// a text for the first time doesn't stall the frame. Glyphs are rasterized
+// on the main thread a few at a time at the beginning of every frame,
+// within a time budget (nanovg and fontstash are not thread-safe).
+class GlyphPrewarmer
+{
+  public:
+    /**
+     * Queues the given characters (UTF-8) to be rasterized
+     * with the given font, at every given font size.
+     */
+    static void prewarm(std::string fontName, std::vector<float> sizes, std::string characters);
+
+    /**
+     * Queues every character used by the loaded translations
+     * to be rasterized with the given font, at every given font size.
+     */
+    static void prewarmTranslations(std::vector<float> sizes, std::string fontName = FONT_REGULAR);
+
+    /**
+     * Returns true if there is no glyph left to rasterize.
+     */
+    static bool isDone();
+
+    /**
+     * Rasterizes queued glyphs until the frame budget is exhausted.
+     * Called by the application at the beginning of every frame.
+     */
+    static void frame();
+
+  private:
+    struct Job
+    {
+        int font;
+        float size;
+        std::string characters;
+        size_t offset = 0;
+    };
+
+    inline static std::deque<Job> jobs;
 };
 
 } // namespace brls
@@ -22,10 +22,15 @@
 #include <borealis/core/font.hpp>
 #include <borealis/core/style.hpp>
 #include <borealis/core/theme.hpp>
+#include <vector>
 
 namespace brls
 {
 
+// The nanovg state is not saved around every view: views that change
+// the scissor save and restore only that part of the state through the
+// scissor stack of the frame context, which doesn't copy the whole
+// nanovg state and is not limited in depth.
 class FrameContext
 {
   public:
@@ -33,6 +38,23 @@ class FrameContext
     float pixelRatio     = 0.0;
     FontStash* fontStash = nullptr;
     Theme theme          = nullptr;
+
+    // Alpha of the view being drawn, multiplied by the alpha of all its ancestors
+    float alpha = 1.0f;
+
+    /**
+     * Intersects the current scissor with the given rectangle,
+     * until the matching popScissor().
+     */
+    void pushScissor(float x, float y, float width, float height);
+
+    /**
+     * Restores the scissor saved by the last pushScissor().
+     */
+    void popScissor();
+
+  private:
+    std::vector<NVGscissor> scissors;
 };
 
 } // namespace brls
@@ -20,6 +20,7 @@
 
 #include <borealis/core/logger.hpp>
 #include <string>
+#include <string_view>
 
 namespace brls
 {
@@ -47,7 +48,11 @@ const std::string LOCALE_DEFAULT = LOCALE_EN_US;
 
 namespace internal
 {
-    std::string getRawStr(std::string stringName);
+    /**
+     * Returns the translation for the given string, or the
+     * string name itself if there is none. Doesn't allocate.
+     */
+    std::string_view getRawStr(std::string_view stringName);
 } // namespace internal
 
 /**
@@ -57,7 +62,7 @@ namespace internal
 template <typename... Args>
 std::string getStr(std::string stringName, Args&&... args)
 {
-    std::string rawStr = internal::getRawStr(stringName);
+    std::string_view rawStr = internal::getRawStr(stringName);
 
     try
     {
@@ -72,10 +77,24 @@ std::string getStr(std::string stringName, Args&&... args)
 
 /**
  * Loads all translations of the current system locale + default locale
+ * into a flat table, strings missing from the current locale are taken
+ * from the default one.
  * Must be called before trying to get a translation!
  */
 void loadTranslations();
 
+/**
+ * Same as loadTranslations(), with the given locale
+ * instead of the system one.
+ */
+void loadTranslations(std::string locale);
+
+/**
+ * Returns every character used by the loaded translations,
+ * without duplicates, as an UTF-8 string
+ */
+std::string getTranslationsCharacters();
+
 inline namespace literals
 {
     /**
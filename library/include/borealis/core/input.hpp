@@ -69,7 +69,7 @@ enum ControllerAxis
 typedef struct ControllerState
 {
     bool buttons[_BUTTON_MAX]; // true: pressed
-    float axes[_AXES_MAX]; // from 0.0f to 1.0f
+    float axes[_AXES_MAX]; // from -1.0f to 1.0f, positive is right / down
 } ControllerState;
 
 // Interface responsible for reporting input state to the application - button presses,
@@ -0,0 +1,115 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <stdio.h>
+
+#include <borealis/core/time.hpp>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace brls
+{
+
+enum class LogLevel
+{
+    ERROR = 0,
+    WARNING,
+    INFO,
+    DEBUG
+};
+
+/**
+ * Returns the name of the given log level ("DEBUG"...).
+ */
+const char* getLogLevelName(LogLevel level);
+
+// Destination of the log messages, see Logger::addSink()
+//
+// Sinks are called from the logger thread when the logger is asynchronous,
+// or from the logging thread otherwise, but never from two threads at once.
+class LogSink
+{
+  public:
+    virtual ~LogSink() {};
+
+    /**
+     * Writes the given message. The time is the one
+     * returned by getCPUTimeUsec() when it was logged.
+     */
+    virtual void write(LogLevel level, Time time, std::string_view message) = 0;
+
+    /**
+     * Called after writing a batch of messages.
+     */
+    virtual void flush() {};
+};
+
+// Writes the messages to stdout, with colors
+class ConsoleLogSink : public LogSink
+{
+  public:
+    void write(LogLevel level, Time time, std::string_view message) override;
+    void flush() override;
+};
+
+// Writes the messages to a file, with their time
+class FileLogSink : public LogSink
+{
+  public:
+    /**
+     * Opens the given file for writing, appending to it if it exists.
+     */
+    FileLogSink(std::string path);
+    ~FileLogSink();
+
+    bool isOpen();
+
+    void write(LogLevel level, Time time, std::string_view message) override;
+    void flush() override;
+
+  private:
+    FILE* file = nullptr;
+};
+
+// Keeps the last messages in memory, to display them in the app
+class MemoryLogSink : public LogSink
+{
+  public:
+    MemoryLogSink(size_t maxLines);
+
+    /**
+     * Returns a copy of the kept messages, oldest first.
+     * Can be called from any thread.
+     */
+    std::vector<std::string> getLines();
+
+    void clear();
+
+    void write(LogLevel level, Time time, std::string_view message) override;
+
+  private:
+    size_t maxLines;
+
+    std::mutex mutex;
+    std::deque<std::string> lines;
+};
+
+} // namespace brls
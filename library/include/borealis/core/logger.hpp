@@ -17,75 +17,142 @@
 
 #pragma once
 
-#include <fmt/core.h>
+#include <fmt/format.h>
 
+#include <borealis/core/log_sink.hpp>
+#include <exception>
 #include <string>
 
-namespace brls
-{
+// Minimum log level compiled in, messages below it are removed at compile time
+// Define it to one of the values below to strip logs from a build, for instance with
+// -DBRLS_LOG_LEVEL=BRLS_LOG_LEVEL_INFO to only keep errors, warnings and infos
+#define BRLS_LOG_LEVEL_ERROR 0
+#define BRLS_LOG_LEVEL_WARNING 1
+#define BRLS_LOG_LEVEL_INFO 2
+#define BRLS_LOG_LEVEL_DEBUG 3
+
+#ifndef BRLS_LOG_LEVEL
+#define BRLS_LOG_LEVEL BRLS_LOG_LEVEL_DEBUG
+#endif
 
-enum class LogLevel
+// Logging macros: unlike the Logger methods, the arguments are not evaluated at all
+// when the level is disabled, at runtime or at compile time. The format string must be
+// a literal and is checked at compile time. Use them when the arguments are expensive to get:
+//   BRLS_LOG_DEBUG("Giving focus to {}", view->describe());
+#define BRLS_LOG(level, format, ...)                                     \
+    do                                                                   \
+    {                                                                    \
+        if (brls::Logger::isLogLevelEnabled(level))                      \
+            brls::Logger::log(level, FMT_STRING(format), ##__VA_ARGS__); \
+    } while (0)
+
+#define BRLS_LOG_ERROR(format, ...) BRLS_LOG(brls::LogLevel::ERROR, format, ##__VA_ARGS__)
+#define BRLS_LOG_WARNING(format, ...) BRLS_LOG(brls::LogLevel::WARNING, format, ##__VA_ARGS__)
+#define BRLS_LOG_INFO(format, ...) BRLS_LOG(brls::LogLevel::INFO, format, ##__VA_ARGS__)
+#define BRLS_LOG_DEBUG(format, ...) BRLS_LOG(brls::LogLevel::DEBUG, format, ##__VA_ARGS__)
+
+namespace brls
 {
-    ERROR = 0,
-    WARNING,
-    INFO,
-    DEBUG
-};
 
+// Formats the messages on the calling thread and queues them in a lock-free ring buffer,
+// drained by a background thread into the sinks (console by default). Until setAsynchronous()
+// is called, which Application::init() does, the messages are written to the sinks right away.
+//
+// The format strings can be wrapped in FMT_STRING() to be checked at compile time.
+// Messages longer than LOG_MESSAGE_MAX_LENGTH are truncated. When the ring buffer is full,
+// messages are dropped and counted instead of blocking the calling thread.
 class Logger
 {
   public:
     static void setLogLevel(LogLevel logLevel);
+    static LogLevel getLogLevel();
 
-    template <typename... Args>
-    inline static void log(LogLevel logLevel, std::string prefix, std::string color, std::string format, Args&&... args)
+    /**
+     * Returns true if messages of the given level are logged,
+     * according to both the runtime and the compile time levels.
+     */
+    inline static bool isLogLevelEnabled(LogLevel logLevel)
     {
-        if (Logger::logLevel < logLevel)
+        return (int)logLevel <= BRLS_LOG_LEVEL && logLevel <= Logger::logLevel;
+    }
+
+    /**
+     * Starts or stops the logger thread. When stopping it,
+     * the queued messages are written first.
+     */
+    static void setAsynchronous(bool asynchronous);
+
+    /**
+     * Writes all queued messages to the sinks on the calling thread.
+     * Errors are always flushed right away.
+     */
+    static void flush();
+
+    /**
+     * Adds the given sink. The sink is not owned by the logger
+     * and must be removed before being deleted.
+     */
+    static void addSink(LogSink* sink);
+    static void removeSink(LogSink* sink);
+
+    /**
+     * Returns the console sink, added by default.
+     */
+    static ConsoleLogSink* getConsoleSink();
+
+    template <typename S, typename... Args>
+    inline static void log(LogLevel logLevel, const S& format, Args&&... args)
+    {
+        if (!Logger::isLogLevelEnabled(logLevel))
             return;
 
+        fmt::memory_buffer buffer;
+
         try
         {
-            fmt::print("\033{}[{}]\033[0m ", color, prefix);
-            fmt::print(format, args...);
-            fmt::print("\n");
+            fmt::format_to(buffer, format, args...);
         }
         catch (const std::exception& e)
         {
-            // will be printed after the first fmt::print (so after the log tag)
-            printf("! Invalid log format string: \"%s\": %s\n", format.c_str(), e.what());
+            buffer.clear();
+            fmt::format_to(buffer, "! Invalid log format string: \"{}\": {}", fmt::to_string_view(format), e.what());
         }
 
-#ifdef __MINGW32__
-        fflush(0);
-#endif
+        Logger::write(logLevel, buffer.data(), buffer.size());
     }
 
-    template <typename... Args>
-    inline static void error(std::string format, Args&&... args)
+    template <typename S, typename... Args>
+    inline static void error(const S& format, Args&&... args)
     {
-        Logger::log(LogLevel::ERROR, "ERROR", "[0;31m", format, args...);
+        Logger::log(LogLevel::ERROR, format, args...);
     }
 
-    template <typename... Args>
-    inline static void warning(std::string format, Args&&... args)
+    template <typename S, typename... Args>
+    inline static void warning(const S& format, Args&&... args)
     {
-        Logger::log(LogLevel::WARNING, "WARNING", "[0;33m", format, args...);
+        Logger::log(LogLevel::WARNING, format, args...);
     }
 
-    template <typename... Args>
-    inline static void info(std::string format, Args&&... args)
+    template <typename S, typename... Args>
+    inline static void info(const S& format, Args&&... args)
     {
-        Logger::log(LogLevel::INFO, "INFO", "[0;34m", format, args...);
+        Logger::log(LogLevel::INFO, format, args...);
     }
 
-    template <typename... Args>
-    inline static void debug(std::string format, Args&&... args)
+    template <typename S, typename... Args>
+    inline static void debug(const S& format, Args&&... args)
     {
-        Logger::log(LogLevel::DEBUG, "DEBUG", "[0;32m", format, args...);
+        Logger::log(LogLevel::DEBUG, format, args...);
     }
 
   private:
     inline static LogLevel logLevel = LogLevel::INFO;
+
+    /**
+     * Queues the given formatted message, or writes it right away
+     * if the logger is synchronous.
+     */
+    static void write(LogLevel logLevel, const char* message, size_t length);
 };
 
 } // namespace brls
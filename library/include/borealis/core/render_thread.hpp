@@ -0,0 +1,149 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+
+#include <borealis/core/video.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace brls
+{
+
+// Submits the frames drawn by the main thread to the GPU from a separate thread.
+//
+// While the render thread tessellates, submits and presents frame N, the main thread
+// runs the input, animations and views of frame N + 1 and records its nanovg calls.
+// At most "depth" frames can be waiting for the render thread: past that, the main thread
+// blocks when ending its frame, which bounds the added latency to "depth" frames.
+//
+// The render thread owns the graphics context for its whole lifetime. The texture
+// callbacks of the nanovg context are forwarded to it, in order with the frames: creating
+// and reading textures blocks the main thread until the render thread catches up, updating
+// and deleting them doesn't. Updated pixels are copied so that the main thread can keep
+// changing its buffer (the font atlas) while the upload is queued.
+class RenderThread
+{
+  public:
+    /**
+     * Takes the graphics context of the given video context and starts
+     * the render thread. Must be called from the main thread, outside of a frame.
+     */
+    RenderThread(VideoContext* videoContext, unsigned depth);
+
+    /**
+     * Submits the queued frames, stops the render thread and
+     * gives the graphics context back to the main thread.
+     */
+    ~RenderThread();
+
+    /**
+     * Returns an empty frame to end the current nanovg frame into,
+     * waiting for the render thread if the queue is full.
+     */
+    NVGframe* acquireFrame();
+
+    /**
+     * Queues the given frame, acquired with acquireFrame(), to be cleared
+     * with the given color, submitted and presented by the render thread.
+     */
+    void submitFrame(NVGframe* frame, NVGcolor clearColor);
+
+    /**
+     * Runs the given task on the render thread after the queued frames,
+     * and waits for it to be done.
+     */
+    void runSync(std::function<void()> task);
+
+    /**
+     * Runs the given task on the render thread after the queued frames.
+     */
+    void runAsync(std::function<void()> task);
+
+    /**
+     * Queues the given task to be run by the main thread,
+     * in runMainThreadTasks(). Can be called from any thread.
+     */
+    void postToMainThread(std::function<void()> task);
+
+    /**
+     * Runs the tasks posted to the main thread.
+     * Called by the application at the beginning of every frame.
+     */
+    void runMainThreadTasks();
+
+    bool isRenderThread();
+
+    unsigned getDepth();
+
+  private:
+    // Either a frame or a task
+    struct Item
+    {
+        NVGframe* frame;
+        NVGcolor clearColor;
+        std::function<void()> task;
+    };
+
+    // Layout of the texture pixels, to copy updated rows
+    struct TextureLayout
+    {
+        int type;
+        int width;
+    };
+
+    VideoContext* videoContext;
+    NVGcontext* vg;
+    NVGparams realParams; // texture callbacks forwarded to the render thread
+    unsigned depth;
+
+    std::thread thread;
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+
+    std::deque<Item> queue;
+    std::vector<NVGframe*> frames;
+    std::vector<NVGframe*> freeFrames;
+    unsigned framesInFlight = 0; // acquired and not presented yet
+    bool stopping           = false;
+
+    std::unordered_map<int, TextureLayout> textures; // main thread only
+
+    std::mutex mainThreadTasksMutex;
+    std::vector<std::function<void()>> mainThreadTasks;
+
+    void threadMain();
+    void push(Item item);
+
+    static int createTexture(void* userPtr, int type, int w, int h, int imageFlags, const unsigned char* data);
+    static int deleteTexture(void* userPtr, int image);
+    static int updateTexture(void* userPtr, int image, int x, int y, int w, int h, const unsigned char* data);
+    static int getTextureSize(void* userPtr, int image, int* w, int* h);
+    static void viewport(void* userPtr, float width, float height, float devicePixelRatio);
+    static void cancel(void* userPtr);
+    static void flush(void* userPtr);
+};
+
+} // namespace brls
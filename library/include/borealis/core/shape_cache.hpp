@@ -0,0 +1,107 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace brls
+{
+
+// Draws the shapes drawn on every frame (highlight, shadows, borders,
+// rounded backgrounds) without tessellating them every time.
+//
+// When the render back-end supports it, shapes are drawn as a single quad
+// with the analytic rounded rectangle primitive of nanovg. Otherwise, their
+// tessellated geometry is cached, keyed by their size: as long as the size
+// doesn't change, drawing them again only moves their vertices. In both cases
+// their color, gradient and alpha can be animated freely.
+//
+// Cached shapes that are not drawn for a while are evicted.
+class ShapeCache
+{
+  public:
+    /**
+     * Fills a rounded rectangle with the current fill paint.
+     */
+    static void fillRoundedRect(NVGcontext* vg, float x, float y, float width, float height, float radius);
+
+    /**
+     * Strokes a rounded rectangle with the current stroke paint.
+     */
+    static void strokeRoundedRect(NVGcontext* vg, float x, float y, float width, float height, float radius, float strokeWidth);
+
+    /**
+     * Fills the shadow of a rounded rectangle with the current fill paint: a rectangle
+     * grown by the given offset (three times the offset at the bottom), minus the rounded
+     * rectangle itself.
+     */
+    static void fillShadow(NVGcontext* vg, float x, float y, float width, float height, float radius, float offset);
+
+    /**
+     * Evicts the shapes that have not been drawn recently.
+     * Called by the application at the beginning of every frame.
+     */
+    static void frame();
+
+    /**
+     * Deletes every cached shape. Must be called before
+     * the nanovg context is deleted.
+     */
+    static void clear();
+
+  private:
+    enum class ShapeType
+    {
+        ROUNDED_RECT_FILL,
+        ROUNDED_RECT_STROKE,
+        SHADOW,
+    };
+
+    struct Key
+    {
+        ShapeType type;
+        float width, height, radius;
+        float param; // stroke width or shadow offset
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        NVGgeometry* geometry;
+        uint32_t lastFrame;
+    };
+
+    inline static std::unordered_map<Key, Entry, KeyHash> entries;
+    inline static uint32_t currentFrame = 0;
+
+    static void draw(NVGcontext* vg, Key key, float x, float y);
+    static void buildPath(NVGcontext* vg, Key key, float x, float y);
+    static void drawPath(NVGcontext* vg, Key key, float x, float y);
+    static void drawPrimitive(NVGcontext* vg, Key key, float x, float y);
+};
+
+} // namespace brls
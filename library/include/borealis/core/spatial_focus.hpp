@@ -0,0 +1,96 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/view.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace brls
+{
+
+// Uniform grid of the focusable views of a Box subtree, used to resolve
+// focus geometrically (nearest view in the pressed direction) instead of
+// walking siblings along the box axis. See Box::setSpatialNavigation().
+//
+// Every view of the subtree is registered in the index, but only focusable
+// views are put in the grid. Frames are cached relative to the root box
+// and refreshed lazily: Yoga layout events only mark views as dirty, and
+// dirty frames are recomputed on the next lookup.
+//
+// Views inside a nested ScrollingFrame are not tracked correctly since
+// scrolling does not trigger any layout event.
+class SpatialFocusIndex
+{
+  public:
+    SpatialFocusIndex(Box* root);
+    ~SpatialFocusIndex();
+
+    /**
+     * Registers the given view and all its children in the index.
+     * Children of a nested spatial navigation box are left to the nested index.
+     */
+    void add(View* view);
+
+    /**
+     * Unregisters the given view and all its children from the index.
+     */
+    void remove(View* view);
+
+    /**
+     * Marks the frame of the given view and of all its children as dirty.
+     * Called on every Yoga layout event.
+     */
+    void invalidate(View* view);
+
+    /**
+     * Returns the nearest focusable view in the given direction, starting
+     * from the given view, or nullptr if there is none.
+     */
+    View* getNextFocus(FocusDirection direction, View* currentFocus);
+
+  private:
+    struct Entry
+    {
+        float x = 0.0f, y = 0.0f, width = 0.0f, height = 0.0f; // relative to the root box
+
+        bool inGrid = false;
+        uint64_t cell = 0;
+    };
+
+    Box* root;
+
+    std::unordered_map<View*, Entry> entries;
+    std::unordered_map<uint64_t, std::vector<View*>> cells;
+    std::unordered_set<View*> dirtyViews;
+
+    // Bounds of the grid, in cells
+    int32_t minCellX = 0, minCellY = 0, maxCellX = -1, maxCellY = -1;
+
+    void addEntry(View* view);
+    void removeEntry(View* view);
+
+    void refresh();
+    void refreshEntry(View* view, Entry* entry);
+    void removeFromGrid(View* view, Entry* entry);
+
+    void getFrame(View* view, float* x, float* y, float* width, float* height);
+};
+
+} // namespace brls
@@ -0,0 +1,76 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace brls
+{
+
+// A fixed set of worker threads running parallel loops.
+//
+// Loop indices are handed out one by one to the workers and to the calling
+// thread as they become idle, so uneven jobs are balanced automatically.
+class ThreadPool
+{
+  public:
+    /**
+     * Starts the given number of worker threads. The thread calling
+     * parallelFor() takes part in the loop, so a pool using N cores
+     * needs N - 1 workers.
+     */
+    ThreadPool(unsigned workers);
+    ~ThreadPool();
+
+    /**
+     * Calls job(i) for every i in [0, count), spread over the workers
+     * and the calling thread, and returns once all the calls are done.
+     *
+     * Must only be called from one thread at a time.
+     */
+    void parallelFor(size_t count, std::function<void(size_t)> job);
+
+    unsigned getWorkersCount();
+
+  private:
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+
+    // Current loop, written under the mutex before bumping the generation
+    std::function<void(size_t)> job;
+    size_t count = 0;
+    std::atomic<size_t> next;
+
+    uint64_t generation = 0;
+    unsigned busyWorkers = 0;
+    bool stopping        = false;
+
+    void workerMain(unsigned index);
+    void runJobs();
+};
+
+} // namespace brls
@@ -47,8 +47,17 @@ class VideoContext
      * Can be called by the application to reset the graphics
      * state, in case there is a need to use the graphics API
      * directly (for instance direct OpenGL calls).
+     * Not available when the render pipeline is enabled, since
+     * the graphics context then belongs to the render thread.
      */
     virtual void resetState() = 0;
 
+    /**
+     * Binds the graphics context to the calling thread, or unbinds it.
+     * Used to move the context to the render thread and back, when
+     * the render pipeline is enabled.
+     */
+    virtual void makeCurrent(bool current) {};
+
     virtual NVGcontext* getNVGContext() = 0;
 };
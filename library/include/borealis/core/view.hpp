@@ -17,7 +17,6 @@
 
 #pragma once
 
-#include <cxxabi.h>
 #include <nanovg.h>
 #include <stdio.h>
 #include <tinyxml2.h>
@@ -25,13 +24,17 @@
 
 #include <borealis/core/actions.hpp>
 #include <borealis/core/animation.hpp>
+#include <borealis/core/bxml.hpp>
 #include <borealis/core/event.hpp>
 #include <borealis/core/frame_context.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/core/view_arena.hpp>
 #include <functional>
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
+#include <typeindex>
 #include <unordered_map>
 #include <vector>
 
@@ -128,6 +131,10 @@ extern const NVGcolor transparent;
 
 class View;
 class Box;
+class SpatialFocusIndex;
+
+// IDs of all the views of a tree, only allocated on the root view of the tree
+typedef std::unordered_map<std::string, std::vector<View*>> ViewIdIndex;
 
 typedef Event<View*> GenericEvent;
 typedef Event<> VoidEvent;
@@ -203,10 +210,21 @@ class View
     std::vector<Action> actions;
 
     /**
-     * Parent user data, typically the index of the view
-     * in the internal layout structure
+     * Index of the view in its parent children list,
+     * kept up to date by the parent
      */
-    void* parentUserdata = nullptr;
+    size_t parentIndex = 0;
+
+    SpatialFocusIndex* spatialFocusIndex = nullptr;
+
+    ViewIdIndex* idIndex = nullptr; // only set on the root view of the tree
+
+    bool ygNodeInArena = false;
+
+    View* getRootView();
+    ViewIdIndex* getIdIndex();
+    bool isInSubtreeOf(View* view);
+    View* searchView(std::string id); // depth-first search, without the index
 
     bool culled = true; // will be culled by the parent Box, if any
 
@@ -223,7 +241,7 @@ class View
     std::set<std::string> knownAttributes;
 
     void registerCommonAttributes();
-    void printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::string name, std::string value);
+    void printXMLAttributeErrorMessage(std::string tag, std::string name, std::string value);
 
     unsigned maximumAllowedXMLElements = UINT_MAX;
 
@@ -259,6 +277,9 @@ class View
 
     std::string id = "";
 
+    // Alpha of the view during the last frame, ancestors included (see FrameContext::alpha)
+    float frameAlpha = 1.0f;
+
     // Helper functions to apply this view's alpha to a color
     NVGcolor a(NVGcolor color);
     NVGpaint a(NVGpaint paint);
@@ -298,6 +319,13 @@ class View
     View();
     virtual ~View();
 
+    /**
+     * Views are allocated in the current view arena if there is one,
+     * on the heap otherwise. See ViewArena.
+     */
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+
     void setBackground(ViewBackground background);
 
     void shakeHighlight(FocusDirection direction);
@@ -325,8 +353,10 @@ class View
      * Returns the view with the corresponding id in the view or its children,
      * or nullptr if it hasn't been found.
      *
-     * Research is done recursively by traversing the tree starting from this view.
-     * This view's parents are not traversed.
+     * Research is done using the IDs index of the whole tree, which is kept up to date
+     * when setting IDs and adding or removing views. Only views that are children of this
+     * view are returned. If multiple children have the same ID, the first one in
+     * depth-first order is returned.
      */
     virtual View* getView(std::string id);
 
@@ -762,7 +792,6 @@ class View
      * of this view. The siblings are searched as well as its children.
      *
      * Research is done by traversing the tree upwards, starting from this view.
-     * The current algorithm is very inefficient.
      */
     virtual View* getNearestView(std::string id);
 
@@ -788,10 +817,39 @@ class View
      */
     static View* createFromXMLElement(tinyxml2::XMLElement* element);
 
+    /**
+     * Creates a view from the root element of the given compiled XML document.
+     *
+     * The method handleBXMLElement() is executed for each child node in the document.
+     */
+    static View* createFromBXML(BXMLDocument* document);
+
+    /**
+     * Creates a view from the given compiled XML element (node and attributes).
+     *
+     * The method handleBXMLElement() is executed for each child node in the document.
+     */
+    static View* createFromBXMLElement(BXMLElement element);
+
+    /**
+     * Creates the view of the given compiled XML element and applies its
+     * attributes, without its children. Used with handleBXMLChild() to
+     * inflate a document one element at a time.
+     */
+    static View* instantiateBXMLElement(BXMLElement element);
+
+    /**
+     * Handles the child compiled XML element at the given index with handleBXMLElement(),
+     * checking the maximum allowed children count.
+     */
+    void handleBXMLChild(BXMLElement child, unsigned index);
+
     /**
      * Creates a view from the given XML file path.
      *
-     * The method handleXMLElement() is executed for each child node in the XML.
+     * If a compiled ".bxml" file newer than the XML file exists next to it,
+     * it is used instead and handleBXMLElement() is executed for each
+     * child node. Otherwise, handleXMLElement() is.
      *
      * Uses the internal lookup table to instantiate the views.
      * Use registerXMLView() to add your own views to the table so that
@@ -821,6 +879,18 @@ class View
      */
     virtual void handleXMLElement(tinyxml2::XMLElement* element);
 
+    /**
+     * Handles a child compiled XML element.
+     *
+     * If left unimplemented, converts the element back to XML and gives it
+     * to handleXMLElement(). Views redefining handleXMLElement() can redefine
+     * this method the same way to avoid that conversion.
+     *
+     * Box redefines both, so a Box subclass redefining handleXMLElement()
+     * must redefine this method too to be usable in compiled XML files.
+     */
+    virtual void handleBXMLElement(BXMLElement element);
+
     /**
      * Applies the attributes of the given XML element to the view.
      *
@@ -830,12 +900,28 @@ class View
     virtual void applyXMLAttributes(tinyxml2::XMLElement* element);
 
     /**
-     * Applies the given attribute to the view.
+     * Applies the given attribute to the view, after parsing its
+     * value with classifyXMLValue().
      *
      * You can add your own attributes to by calling registerXMLAttribute()
      * in the view constructor.
+     *
+     * XML inflation doesn't go through this method: override
+     * applyXMLAttributeValue() instead to intercept attributes.
+     */
+    virtual bool applyXMLAttribute(std::string name, std::string value) final;
+
+    /**
+     * Applies the attributes of the given compiled XML element to the view.
+     */
+    virtual void applyBXMLAttributes(BXMLElement element);
+
+    /**
+     * Applies the given typed attribute value to the view by calling the
+     * handler registered for its type. Every XML and compiled XML attribute goes
+     * through this method, override it to intercept them.
      */
-    virtual bool applyXMLAttribute(std::string name, std::string value);
+    virtual bool applyXMLAttributeValue(const std::string& name, const XMLValue& value);
 
     /**
      * Register a new XML attribute with the given name and handler
@@ -970,11 +1056,23 @@ class View
      */
     void setDetachedPosition(float x, float y);
 
-    void setParent(Box* parent, void* parentUserdata = nullptr);
+    void setParent(Box* parent, size_t parentIndex = 0);
     Box* getParent();
     bool hasParent();
 
-    void* getParentUserData();
+    /**
+     * Sets the index of the view in its parent children list.
+     * Taken care of by the parent.
+     */
+    void setParentIndex(size_t parentIndex);
+    size_t getParentIndex();
+
+    /**
+     * Sets the spatial focus index this view is registered in, if any.
+     * Taken care of by the index itself.
+     */
+    void setSpatialFocusIndex(SpatialFocusIndex* index);
+    SpatialFocusIndex* getSpatialFocusIndex();
 
     /**
      * Registers an action with the given parameters. The listener will be fired when the user presses
@@ -1006,28 +1104,41 @@ class View
     void resetClickAnimation();
     void playClickAnimation(bool reverse = false);
 
-    std::string getClassString() const
-    {
-        // Taken from: https://stackoverflow.com/questions/281818/unmangling-the-result-of-stdtype-infoname/4541470#4541470
-        const char* name = typeid(*this).name();
-        int status       = 0;
+    /**
+     * Returns the demangled name of the given type. Names are demangled
+     * once per type and kept for the whole lifetime of the app.
+     */
+    static std::string_view getClassName(std::type_index type);
 
-        std::unique_ptr<char, void (*)(void*)> res {
-            abi::__cxa_demangle(name, NULL, NULL, &status),
-            std::free
-        };
+    /**
+     * Returns the demangled class name of the view ("brls::Box").
+     */
+    std::string_view getClassName() const
+    {
+        return View::getClassName(std::type_index(typeid(*this)));
+    }
 
-        return (status == 0) ? res.get() : name;
+    std::string getClassString() const
+    {
+        return std::string(this->getClassName());
     }
 
     std::string describe() const
     {
-        std::string classString = this->getClassString();
+        std::string_view className = this->getClassName();
+
+        if (this->id.empty())
+            return std::string(className);
+
+        std::string description;
+        description.reserve(className.size() + this->id.size() + 7);
 
-        if (this->id != "")
-            return classString + " (id=\"" + this->id + "\")";
+        description.append(className);
+        description.append(" (id=\"");
+        description.append(this->id);
+        description.append("\")");
 
-        return classString;
+        return description;
     }
 
     YGNode* getYGNode()
@@ -1051,6 +1162,11 @@ class View
       * Called by frame() to draw the view onscreen.
       * Views should not draw outside of their bounds (they
       * may be clipped if they do so).
+      *
+      * The nanovg state is not saved around draw(): use the render state
+      * stacks of the frame context (or nvgSave() and nvgRestore()) to change
+      * the scissor or the transform. Colors, paints and text settings
+      * must be set before drawing anything.
       */
     virtual void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) = 0;
 
@@ -1222,6 +1338,11 @@ class View
 
     Animatable alpha = 1.0f;
 
+    /**
+     * Returns the alpha of the view multiplied by the alpha of all its
+     * ancestors, walking up the tree. When drawing, use FrameContext::alpha
+     * instead, which is computed once per view during the frame traversal.
+     */
     virtual float getAlpha(bool child = false);
 
     /**
@@ -0,0 +1,82 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace brls
+{
+
+// Bump allocator that carves views and their Yoga nodes out of big contiguous blocks,
+// all released at once when the arena is destroyed. Avoids thousands of small allocations
+// when inflating a whole activity from XML, as well as the heap fragmentation that goes with them.
+//
+// Deleting a view allocated in an arena runs its destructor as usual, but its memory
+// is only given back when the arena is destroyed. As such, the views must not outlive the arena.
+//
+// Views are allocated in the current arena, if any (see ViewArenaScope).
+class ViewArena
+{
+  public:
+    ViewArena(size_t blockSize = 64 * 1024);
+    ~ViewArena();
+
+    /**
+     * Allocates the given amount of bytes in the arena.
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Returns the total amount of bytes allocated in the arena.
+     */
+    size_t getAllocatedSize();
+
+    /**
+     * Returns the arena new views are allocated in, or nullptr
+     * if they are allocated on the heap.
+     */
+    static ViewArena* getCurrent();
+
+  private:
+    size_t blockSize;
+    std::vector<uint8_t*> blocks;
+
+    uint8_t* cursor  = nullptr;
+    size_t remaining = 0;
+
+    size_t allocatedSize = 0;
+
+    inline static ViewArena* current = nullptr;
+
+    friend class ViewArenaScope;
+};
+
+// Makes the given arena the current one for the lifetime of the scope.
+// Giving nullptr makes views allocated on the heap.
+class ViewArenaScope
+{
+  public:
+    ViewArenaScope(ViewArena* arena);
+    ~ViewArenaScope();
+
+  private:
+    ViewArena* previous;
+};
+
+} // namespace brls
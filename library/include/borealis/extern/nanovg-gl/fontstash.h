@@ -24,8 +24,16 @@
 enum FONSflags {
 	FONS_ZERO_TOPLEFT = 1,
 	FONS_ZERO_BOTTOMLEFT = 2,
+	FONS_SDF_GLYPHS = 4, // Rasterize glyphs as signed distance fields, see fonsSetSDF()
 };
 
+// Signed distance field glyphs are rasterized once at FONS_SDF_SIZE and scaled when drawn.
+// Distance to the outline is encoded with FONS_SDF_ONEDGE on the edge, decreasing by
+// FONS_SDF_ONEDGE / FONS_SDF_PADDING per pixel outside of the glyph.
+#define FONS_SDF_SIZE 48
+#define FONS_SDF_PADDING 6
+#define FONS_SDF_ONEDGE 128
+
 enum FONSalign {
 	// Horizontal align
 	FONS_ALIGN_LEFT 	= 1<<0,	// Default
@@ -138,6 +146,29 @@ int fonsValidateTexture(FONScontext* s, int* dirty);
 // Draws the stash texture for debugging
 void fonsDrawDebug(FONScontext* s, float x, float y);
 
+// Enables or disables signed distance field glyphs. Blur is ignored in this mode.
+// Glyphs rasterized with the previous mode are kept, the atlas must be reset afterwards.
+void fonsSetSDF(FONScontext* s, int enabled);
+
+// Glyph cache: rasterized glyphs (metrics and bitmap) can be exported and imported back later
+typedef struct FONScachedGlyph {
+	unsigned int codepoint;
+	int index;
+	short size, blur;
+	short width, height; // bitmap size, padding included
+	short xadv, xoff, yoff;
+} FONScachedGlyph;
+
+// Returns the number of glyphs of the given font, rasterized or not.
+int fonsGetGlyphCount(FONScontext* s, int font);
+// Gets the glyph at the given index. Bitmap can be NULL to only get the metrics.
+// Returns 0 if the glyph is not rasterized or if the bitmap is too small.
+int fonsExportGlyph(FONScontext* s, int font, int i, FONScachedGlyph* glyph, unsigned char* bitmap, int bitmapSize);
+// Adds a previously exported glyph to the atlas. Returns 0 if the atlas is full.
+int fonsImportGlyph(FONScontext* s, int font, const FONScachedGlyph* glyph, const unsigned char* bitmap);
+// Returns the data of the given font.
+const unsigned char* fonsGetFontData(FONScontext* s, int font, int* size);
+
 #endif // FONTSTASH_H
 
 
@@ -245,6 +276,17 @@ void fons__tt_renderGlyphBitmap(FONSttFontImpl *font, unsigned char *output, int
 	}
 }
 
+void fons__tt_renderGlyphSDF(FONSttFontImpl *font, unsigned char *output, int outWidth, int outHeight, int outStride,
+							 float scale, int padding, int glyph)
+{
+	// No distance field support, the coverage bitmap is used instead
+	int x, y;
+	for (y = 0; y < outHeight; y++)
+		for (x = 0; x < outWidth; x++)
+			output[x + y*outStride] = 0;
+	fons__tt_renderGlyphBitmap(font, &output[padding + padding*outStride], outWidth-padding*2, outHeight-padding*2, outStride, scale, scale, glyph);
+}
+
 int fons__tt_getGlyphKernAdvance(FONSttFontImpl *font, int glyph1, int glyph2)
 {
 	FT_Vector ftKerning;
@@ -318,6 +360,18 @@ void fons__tt_renderGlyphBitmap(FONSttFontImpl *font, unsigned char *output, int
 	stbtt_MakeGlyphBitmap(&font->font, output, outWidth, outHeight, outStride, scaleX, scaleY, glyph);
 }
 
+void fons__tt_renderGlyphSDF(FONSttFontImpl *font, unsigned char *output, int outWidth, int outHeight, int outStride,
+							 float scale, int padding, int glyph)
+{
+	int x, y, w = 0, h = 0, xoff, yoff;
+	unsigned char* sdf = stbtt_GetGlyphSDF(&font->font, scale, glyph, padding, FONS_SDF_ONEDGE, (float)FONS_SDF_ONEDGE / padding, &w, &h, &xoff, &yoff);
+	for (y = 0; y < outHeight; y++)
+		for (x = 0; x < outWidth; x++)
+			output[x + y*outStride] = (sdf != NULL && x < w && y < h) ? sdf[x + y*w] : 0;
+	if (sdf != NULL)
+		stbtt_FreeSDF(sdf, font->font.userdata);
+}
+
 int fons__tt_getGlyphKernAdvance(FONSttFontImpl *font, int glyph1, int glyph2)
 {
 	return stbtt_GetGlyphKernAdvance(&font->font, glyph1, glyph2);
@@ -1063,8 +1117,14 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	FONSfont* renderFont = font;
 
 	if (isize < 2) return NULL;
+	if (stash->params.flags & FONS_SDF_GLYPHS) {
+		// Distance field glyphs are shared by every size
+		isize = FONS_SDF_SIZE*10;
+		iblur = 0;
+		size = FONS_SDF_SIZE;
+	}
 	if (iblur > 20) iblur = 20;
-	pad = iblur+2;
+	pad = (stash->params.flags & FONS_SDF_GLYPHS) ? FONS_SDF_PADDING : iblur+2;
 
 	// Reset allocator.
 	stash->nscratch = 0;
@@ -1147,8 +1207,13 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	}
 
 	// Rasterize
-	dst = &stash->texData[(glyph->x0+pad) + (glyph->y0+pad) * stash->params.width];
-	fons__tt_renderGlyphBitmap(&renderFont->font, dst, gw-pad*2,gh-pad*2, stash->params.width, scale, scale, g);
+	if (stash->params.flags & FONS_SDF_GLYPHS) {
+		dst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
+		fons__tt_renderGlyphSDF(&renderFont->font, dst, gw, gh, stash->params.width, scale, pad, g);
+	} else {
+		dst = &stash->texData[(glyph->x0+pad) + (glyph->y0+pad) * stash->params.width];
+		fons__tt_renderGlyphBitmap(&renderFont->font, dst, gw-pad*2,gh-pad*2, stash->params.width, scale, scale, g);
+	}
 
 	// Make sure there is one pixel empty border.
 	dst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
@@ -1187,14 +1252,17 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 }
 
 static void fons__getQuad(FONScontext* stash, FONSfont* font,
-						   int prevGlyphIndex, FONSglyph* glyph,
+						   int prevGlyphIndex, FONSglyph* glyph, short isize,
 						   float scale, float spacing, float* x, float* y, FONSquad* q)
 {
 	float rx,ry,xoff,yoff,x0,y0,x1,y1;
+	int sdf = stash->params.flags & FONS_SDF_GLYPHS;
+	// Distance field glyphs are scaled from FONS_SDF_SIZE, and not snapped to pixels
+	float gscale = sdf ? isize / (FONS_SDF_SIZE*10.0f) : 1.0f;
 
 	if (prevGlyphIndex != -1) {
 		float adv = fons__tt_getGlyphKernAdvance(&font->font, prevGlyphIndex, glyph->index) * scale;
-		*x += (int)(adv + spacing + 0.5f);
+		*x += sdf ? adv + spacing : (int)(adv + spacing + 0.5f);
 	}
 
 	// Each glyph has 2px border to allow good interpolation,
@@ -1208,26 +1276,26 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 	y1 = (float)(glyph->y1-1);
 
 	if (stash->params.flags & FONS_ZERO_TOPLEFT) {
-		rx = (float)(int)(*x + xoff);
-		ry = (float)(int)(*y + yoff);
+		rx = sdf ? *x + xoff*gscale : (float)(int)(*x + xoff);
+		ry = sdf ? *y + yoff*gscale : (float)(int)(*y + yoff);
 
 		q->x0 = rx;
 		q->y0 = ry;
-		q->x1 = rx + x1 - x0;
-		q->y1 = ry + y1 - y0;
+		q->x1 = rx + (x1 - x0)*gscale;
+		q->y1 = ry + (y1 - y0)*gscale;
 
 		q->s0 = x0 * stash->itw;
 		q->t0 = y0 * stash->ith;
 		q->s1 = x1 * stash->itw;
 		q->t1 = y1 * stash->ith;
 	} else {
-		rx = (float)(int)(*x + xoff);
-		ry = (float)(int)(*y - yoff);
+		rx = sdf ? *x + xoff*gscale : (float)(int)(*x + xoff);
+		ry = sdf ? *y - yoff*gscale : (float)(int)(*y - yoff);
 
 		q->x0 = rx;
 		q->y0 = ry;
-		q->x1 = rx + x1 - x0;
-		q->y1 = ry - y1 + y0;
+		q->x1 = rx + (x1 - x0)*gscale;
+		q->y1 = ry - (y1 - y0)*gscale;
 
 		q->s0 = x0 * stash->itw;
 		q->t0 = y0 * stash->ith;
@@ -1235,7 +1303,10 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 		q->t1 = y1 * stash->ith;
 	}
 
-	*x += (int)(glyph->xadv / 10.0f + 0.5f);
+	if (sdf)
+		*x += glyph->xadv / 10.0f * gscale;
+	else
+		*x += (int)(glyph->xadv / 10.0f + 0.5f);
 }
 
 static void fons__flush(FONScontext* stash)
@@ -1339,7 +1410,7 @@ float fonsDrawText(FONScontext* stash,
 			continue;
 		glyph = fons__getGlyph(stash, font, codepoint, isize, iblur, FONS_GLYPH_BITMAP_REQUIRED);
 		if (glyph != NULL) {
-			fons__getQuad(stash, font, prevGlyphIndex, glyph, scale, state->spacing, &x, &y, &q);
+			fons__getQuad(stash, font, prevGlyphIndex, glyph, isize, scale, state->spacing, &x, &y, &q);
 
 			if (stash->nverts+6 > FONS_VERTEX_COUNT)
 				fons__flush(stash);
@@ -1424,7 +1495,7 @@ int fonsTextIterNext(FONScontext* stash, FONStextIter* iter, FONSquad* quad)
 		glyph = fons__getGlyph(stash, iter->font, iter->codepoint, iter->isize, iter->iblur, iter->bitmapOption);
 		// If the iterator was initialized with FONS_GLYPH_BITMAP_OPTIONAL, then the UV coordinates of the quad will be invalid.
 		if (glyph != NULL)
-			fons__getQuad(stash, iter->font, iter->prevGlyphIndex, glyph, iter->scale, iter->spacing, &iter->nextx, &iter->nexty, quad);
+			fons__getQuad(stash, iter->font, iter->prevGlyphIndex, glyph, iter->isize, iter->scale, iter->spacing, &iter->nextx, &iter->nexty, quad);
 		iter->prevGlyphIndex = glyph != NULL ? glyph->index : -1;
 		break;
 	}
@@ -1521,7 +1592,7 @@ float fonsTextBounds(FONScontext* stash,
 			continue;
 		glyph = fons__getGlyph(stash, font, codepoint, isize, iblur, FONS_GLYPH_BITMAP_OPTIONAL);
 		if (glyph != NULL) {
-			fons__getQuad(stash, font, prevGlyphIndex, glyph, scale, state->spacing, &x, &y, &q);
+			fons__getQuad(stash, font, prevGlyphIndex, glyph, isize, scale, state->spacing, &x, &y, &q);
 			if (q.x0 < minx) minx = q.x0;
 			if (q.x1 > maxx) maxx = q.x1;
 			if (stash->params.flags & FONS_ZERO_TOPLEFT) {
@@ -1765,4 +1836,114 @@ int fonsResetAtlas(FONScontext* stash, int width, int height)
 }
 
 
+void fonsSetSDF(FONScontext* stash, int enabled)
+{
+	if (stash == NULL) return;
+	if (enabled)
+		stash->params.flags |= FONS_SDF_GLYPHS;
+	else
+		stash->params.flags &= ~FONS_SDF_GLYPHS;
+}
+
+int fonsGetGlyphCount(FONScontext* stash, int font)
+{
+	if (stash == NULL || font < 0 || font >= stash->nfonts) return 0;
+	return stash->fonts[font]->nglyphs;
+}
+
+int fonsExportGlyph(FONScontext* stash, int font, int i, FONScachedGlyph* glyph, unsigned char* bitmap, int bitmapSize)
+{
+	FONSglyph* g;
+	int y, w, h;
+	if (stash == NULL || font < 0 || font >= stash->nfonts) return 0;
+	if (i < 0 || i >= stash->fonts[font]->nglyphs) return 0;
+
+	g = &stash->fonts[font]->glyphs[i];
+	if (g->x0 < 0 || g->y0 < 0) return 0; // no bitmap
+
+	w = g->x1 - g->x0;
+	h = g->y1 - g->y0;
+
+	glyph->codepoint = g->codepoint;
+	glyph->index = g->index;
+	glyph->size = g->size;
+	glyph->blur = g->blur;
+	glyph->width = (short)w;
+	glyph->height = (short)h;
+	glyph->xadv = g->xadv;
+	glyph->xoff = g->xoff;
+	glyph->yoff = g->yoff;
+
+	if (bitmap == NULL) return 1;
+	if (bitmapSize < w * h) return 0;
+
+	for (y = 0; y < h; y++)
+		memcpy(&bitmap[y * w], &stash->texData[g->x0 + (g->y0 + y) * stash->params.width], w);
+
+	return 1;
+}
+
+int fonsImportGlyph(FONScontext* stash, int font, const FONScachedGlyph* glyph, const unsigned char* bitmap)
+{
+	FONSfont* f;
+	FONSglyph* g = NULL;
+	unsigned int h;
+	int i, y, gx, gy;
+	if (stash == NULL || font < 0 || font >= stash->nfonts) return 0;
+	f = stash->fonts[font];
+
+	// Find existing glyph
+	h = fons__hashint(glyph->codepoint) & (FONS_HASH_LUT_SIZE-1);
+	i = f->lut[h];
+	while (i != -1) {
+		if (f->glyphs[i].codepoint == glyph->codepoint && f->glyphs[i].size == glyph->size && f->glyphs[i].blur == glyph->blur) {
+			g = &f->glyphs[i];
+			if (g->x0 >= 0 && g->y0 >= 0) return 1; // already rasterized
+			break;
+		}
+		i = f->glyphs[i].next;
+	}
+
+	// Find free spot for the rect in the atlas
+	if (fons__atlasAddRect(stash->atlas, glyph->width, glyph->height, &gx, &gy) == 0)
+		return 0;
+
+	// Init glyph
+	if (g == NULL) {
+		g = fons__allocGlyph(f);
+		if (g == NULL) return 0;
+		g->codepoint = glyph->codepoint;
+		g->size = glyph->size;
+		g->blur = glyph->blur;
+		g->next = f->lut[h];
+		f->lut[h] = f->nglyphs-1;
+	}
+	g->index = glyph->index;
+	g->x0 = (short)gx;
+	g->y0 = (short)gy;
+	g->x1 = (short)(gx + glyph->width);
+	g->y1 = (short)(gy + glyph->height);
+	g->xadv = glyph->xadv;
+	g->xoff = glyph->xoff;
+	g->yoff = glyph->yoff;
+
+	// Copy bitmap
+	for (y = 0; y < glyph->height; y++)
+		memcpy(&stash->texData[gx + (gy + y) * stash->params.width], &bitmap[y * glyph->width], glyph->width);
+
+	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], g->x0);
+	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], g->y0);
+	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], g->x1);
+	stash->dirtyRect[3] = fons__maxi(stash->dirtyRect[3], g->y1);
+
+	return 1;
+}
+
+const unsigned char* fonsGetFontData(FONScontext* stash, int font, int* size)
+{
+	if (stash == NULL || font < 0 || font >= stash->nfonts) return NULL;
+	*size = stash->fonts[font]->dataSize;
+	return stash->fonts[font]->data;
+}
+
 #endif
@@ -32,6 +32,12 @@ enum NVGcreateFlags {
 	NVG_STENCIL_STROKES	= 1<<1,
 	// Flag indicating that additional debug checks are done.
 	NVG_DEBUG 			= 1<<2,
+	// Flag indicating that vertices and uniforms are streamed through triple buffered ring buffers,
+	// reused once the GPU is done with them (fences), instead of being reallocated every frame (GL3 only).
+	NVG_STREAM_BUFFERS	= 1<<3,
+	// Flag indicating that the ring buffers are persistently mapped instead of updated with glBufferSubData.
+	// Requires NVG_STREAM_BUFFERS and GL 4.4 or ARB_buffer_storage.
+	NVG_PERSISTENT_BUFFERS	= 1<<4,
 };
 
 #if defined NANOVG_GL2_IMPLEMENTATION
@@ -51,6 +57,19 @@ enum NVGcreateFlags {
 
 #define NANOVG_GL_USE_STATE_FILTER (1)
 
+// Maximum number of consecutive calls merged into one draw. The paints of the merged calls
+// are uploaded together and indexed per vertex in the fragment shader. GLES2 only allows
+// constant indices into fragment uniform arrays, so nothing is merged there.
+#if defined NANOVG_GLES2
+#  define NANOVG_GL_MAX_BATCH 1
+#else
+#  define NANOVG_GL_MAX_BATCH 16
+#endif
+
+#if defined NANOVG_GL3 && (defined GL_VERSION_4_4 || defined GL_ARB_buffer_storage)
+#  define NANOVG_GL_USE_PERSISTENT_BUFFERS 1
+#endif
+
 // Creates NanoVG contexts for different OpenGL (ES) versions.
 // Flags should be combination of the create flags above.
 
@@ -124,7 +143,8 @@ enum GLNVGshaderType {
 	NSVG_SHADER_FILLGRAD,
 	NSVG_SHADER_FILLIMG,
 	NSVG_SHADER_SIMPLE,
-	NSVG_SHADER_IMG
+	NSVG_SHADER_IMG,
+	NSVG_SHADER_SHAPE
 };
 
 #if NANOVG_GL_USE_UNIFORMBUFFER
@@ -176,6 +196,9 @@ struct GLNVGcall {
 	int triangleCount;
 	int uniformOffset;
 	GLNVGblend blendFunc;
+	int batchCount; // number of calls drawn with this one, set on the first call of the batch
+	int indexOffset; // indices of the batched convex fills
+	int indexCount;
 };
 typedef struct GLNVGcall GLNVGcall;
 
@@ -202,10 +225,14 @@ struct GLNVGfragUniforms {
 		float strokeThr;
 		int texType;
 		int type;
+		float shapeMat[12];
+		float shape[4]; // extent, radius, antialiasing width
+		float shapeStroke;
+		int shapeType;
 	#else
 		// note: after modifying layout or size of uniform array,
 		// don't forget to also update the fragment shader source!
-		#define NANOVG_GL_UNIFORMARRAY_SIZE 11
+		#define NANOVG_GL_UNIFORMARRAY_SIZE 16
 		union {
 			struct {
 				float scissorMat[12]; // matrices are actually 3 vec4s
@@ -221,6 +248,10 @@ struct GLNVGfragUniforms {
 				float strokeThr;
 				float texType;
 				float type;
+				float shapeMat[12];
+				float shape[4]; // extent, radius, antialiasing width
+				float shapeStroke;
+				float shapeType;
 			};
 			float uniformArray[NANOVG_GL_UNIFORMARRAY_SIZE][4];
 		};
@@ -228,6 +259,24 @@ struct GLNVGfragUniforms {
 };
 typedef struct GLNVGfragUniforms GLNVGfragUniforms;
 
+#if NANOVG_GL_USE_UNIFORMBUFFER
+// std140 stride of the paints array of the uniform block
+#define GLNVG_PAINT_STRIDE 256
+#endif
+
+#if defined NANOVG_GL3
+// Amount of frames in flight in the streaming ring buffers
+#define GLNVG_STREAM_FRAMES 3
+
+struct GLNVGstream {
+	GLuint buf;
+	GLenum target;
+	int frameSize; // size of the region of one frame, in bytes
+	unsigned char* mapped; // persistent mapping, NULL when using glBufferSubData
+};
+typedef struct GLNVGstream GLNVGstream;
+#endif
+
 struct GLNVGcontext {
 	GLNVGshader shader;
 	GLNVGtexture* textures;
@@ -242,8 +291,22 @@ struct GLNVGcontext {
 #if NANOVG_GL_USE_UNIFORMBUFFER
 	GLuint fragBuf;
 #endif
+	GLuint paintBuf;
+	GLuint indexBuf;
 	int fragSize;
 	int flags;
+	int maxBatch;
+
+#if defined NANOVG_GL3
+	// Streaming ring buffers (NVG_STREAM_BUFFERS)
+	GLNVGstream vertStream;
+	GLNVGstream fragStream;
+	GLNVGstream paintStream;
+	GLNVGstream indexStream;
+	GLsync fences[GLNVG_STREAM_FRAMES];
+	int streamFrame;
+	int fragBase; // offset of the uniforms of the current frame, in bytes
+#endif
 
 	// Per frame buffers
 	GLNVGcall* calls;
@@ -259,6 +322,17 @@ struct GLNVGcontext {
 	int cuniforms;
 	int nuniforms;
 
+	// Batching: paint index of every vertex in its batch (same capacity as verts)
+	// and triangles of the batched convex fills
+	float* paints;
+	GLuint* indices;
+	int cindices;
+	int nindices;
+	size_t indexBase; // offset of the indices of the current frame, in bytes
+#if !NANOVG_GL_USE_UNIFORMBUFFER
+	float* batchUniforms; // paints of a batch, packed for glUniform4fv
+#endif
+
 	// cached state
 	#if NANOVG_GL_USE_STATE_FILTER
 	GLuint boundTexture;
@@ -463,6 +537,7 @@ static int glnvg__createShader(GLNVGshader* shader, const char* name, const char
 
 	glBindAttribLocation(prog, 0, "vertex");
 	glBindAttribLocation(prog, 1, "tcoord");
+	glBindAttribLocation(prog, 2, "paint");
 
 	glLinkProgram(prog);
 	glGetProgramiv(prog, GL_LINK_STATUS, &status);
@@ -524,7 +599,7 @@ static int glnvg__renderCreate(void* uptr)
 #if NANOVG_GL_USE_UNIFORMBUFFER
 	"#define USE_UNIFORMBUFFER 1\n"
 #else
-	"#define UNIFORMARRAY_SIZE 11\n"
+	"#define UNIFORMARRAY_SIZE 16\n"
 #endif
 	"\n";
 
@@ -533,18 +608,23 @@ static int glnvg__renderCreate(void* uptr)
 		"	uniform vec2 viewSize;\n"
 		"	in vec2 vertex;\n"
 		"	in vec2 tcoord;\n"
+		"	in float paint;\n"
 		"	out vec2 ftcoord;\n"
 		"	out vec2 fpos;\n"
+		"	out float fpaint;\n"
 		"#else\n"
 		"	uniform vec2 viewSize;\n"
 		"	attribute vec2 vertex;\n"
 		"	attribute vec2 tcoord;\n"
+		"	attribute float paint;\n"
 		"	varying vec2 ftcoord;\n"
 		"	varying vec2 fpos;\n"
+		"	varying float fpaint;\n"
 		"#endif\n"
 		"void main(void) {\n"
 		"	ftcoord = tcoord;\n"
 		"	fpos = vertex;\n"
+		"	fpaint = paint;\n"
 		"	gl_Position = vec4(2.0*vertex.x/viewSize.x - 1.0, 1.0 - 2.0*vertex.y/viewSize.y, 0, 1);\n"
 		"}\n";
 
@@ -558,7 +638,7 @@ static int glnvg__renderCreate(void* uptr)
 		"#endif\n"
 		"#ifdef NANOVG_GL3\n"
 		"#ifdef USE_UNIFORMBUFFER\n"
-		"	layout(std140) uniform frag {\n"
+		"	struct Paint {\n"
 		"		mat3 scissorMat;\n"
 		"		mat3 paintMat;\n"
 		"		vec4 innerCol;\n"
@@ -572,34 +652,72 @@ static int glnvg__renderCreate(void* uptr)
 		"		float strokeThr;\n"
 		"		int texType;\n"
 		"		int type;\n"
+		"		mat3 shapeMat;\n"
+		"		vec4 shape;\n"
+		"		float shapeStroke;\n"
+		"		int shapeType;\n"
+		"	};\n"
+		"	layout(std140) uniform frag {\n"
+		"		Paint paints[PAINT_COUNT];\n"
 		"	};\n"
 		"#else\n" // NANOVG_GL3 && !USE_UNIFORMBUFFER
-		"	uniform vec4 frag[UNIFORMARRAY_SIZE];\n"
+		"	uniform vec4 frag[UNIFORMARRAY_SIZE * PAINT_COUNT];\n"
 		"#endif\n"
 		"	uniform sampler2D tex;\n"
 		"	in vec2 ftcoord;\n"
 		"	in vec2 fpos;\n"
+		"	in float fpaint;\n"
 		"	out vec4 outColor;\n"
 		"#else\n" // !NANOVG_GL3
-		"	uniform vec4 frag[UNIFORMARRAY_SIZE];\n"
+		"	uniform vec4 frag[UNIFORMARRAY_SIZE * PAINT_COUNT];\n"
 		"	uniform sampler2D tex;\n"
 		"	varying vec2 ftcoord;\n"
 		"	varying vec2 fpos;\n"
+		"	varying float fpaint;\n"
+		"#endif\n"
+		"// Index of the paint of the fragment in the batch\n"
+		"#if PAINT_COUNT > 1\n"
+		"	int paintIndex;\n"
+		"#else\n"
+		"	#define paintIndex 0\n"
 		"#endif\n"
-		"#ifndef USE_UNIFORMBUFFER\n"
-		"	#define scissorMat mat3(frag[0].xyz, frag[1].xyz, frag[2].xyz)\n"
-		"	#define paintMat mat3(frag[3].xyz, frag[4].xyz, frag[5].xyz)\n"
-		"	#define innerCol frag[6]\n"
-		"	#define outerCol frag[7]\n"
-		"	#define scissorExt frag[8].xy\n"
-		"	#define scissorScale frag[8].zw\n"
-		"	#define extent frag[9].xy\n"
-		"	#define radius frag[9].z\n"
-		"	#define feather frag[9].w\n"
-		"	#define strokeMult frag[10].x\n"
-		"	#define strokeThr frag[10].y\n"
-		"	#define texType int(frag[10].z)\n"
-		"	#define type int(frag[10].w)\n"
+		"#ifdef USE_UNIFORMBUFFER\n"
+		"	#define scissorMat paints[paintIndex].scissorMat\n"
+		"	#define paintMat paints[paintIndex].paintMat\n"
+		"	#define innerCol paints[paintIndex].innerCol\n"
+		"	#define outerCol paints[paintIndex].outerCol\n"
+		"	#define scissorExt paints[paintIndex].scissorExt\n"
+		"	#define scissorScale paints[paintIndex].scissorScale\n"
+		"	#define extent paints[paintIndex].extent\n"
+		"	#define radius paints[paintIndex].radius\n"
+		"	#define feather paints[paintIndex].feather\n"
+		"	#define strokeMult paints[paintIndex].strokeMult\n"
+		"	#define strokeThr paints[paintIndex].strokeThr\n"
+		"	#define texType paints[paintIndex].texType\n"
+		"	#define type paints[paintIndex].type\n"
+		"	#define shapeMat paints[paintIndex].shapeMat\n"
+		"	#define shape paints[paintIndex].shape\n"
+		"	#define shapeStroke paints[paintIndex].shapeStroke\n"
+		"	#define shapeType paints[paintIndex].shapeType\n"
+		"#else\n"
+		"	#define paintBase (paintIndex * UNIFORMARRAY_SIZE)\n"
+		"	#define scissorMat mat3(frag[paintBase + 0].xyz, frag[paintBase + 1].xyz, frag[paintBase + 2].xyz)\n"
+		"	#define paintMat mat3(frag[paintBase + 3].xyz, frag[paintBase + 4].xyz, frag[paintBase + 5].xyz)\n"
+		"	#define innerCol frag[paintBase + 6]\n"
+		"	#define outerCol frag[paintBase + 7]\n"
+		"	#define scissorExt frag[paintBase + 8].xy\n"
+		"	#define scissorScale frag[paintBase + 8].zw\n"
+		"	#define extent frag[paintBase + 9].xy\n"
+		"	#define radius frag[paintBase + 9].z\n"
+		"	#define feather frag[paintBase + 9].w\n"
+		"	#define strokeMult frag[paintBase + 10].x\n"
+		"	#define strokeThr frag[paintBase + 10].y\n"
+		"	#define texType int(frag[paintBase + 10].z)\n"
+		"	#define type int(frag[paintBase + 10].w)\n"
+		"	#define shapeMat mat3(frag[paintBase + 11].xyz, frag[paintBase + 12].xyz, frag[paintBase + 13].xyz)\n"
+		"	#define shape frag[paintBase + 14]\n"
+		"	#define shapeStroke frag[paintBase + 15].x\n"
+		"	#define shapeType int(frag[paintBase + 15].y)\n"
 		"#endif\n"
 		"\n"
 		"float sdroundrect(vec2 pt, vec2 ext, float rad) {\n"
@@ -623,6 +741,9 @@ static int glnvg__renderCreate(void* uptr)
 		"\n"
 		"void main(void) {\n"
 		"   vec4 result;\n"
+		"#if PAINT_COUNT > 1\n"
+		"	paintIndex = int(fpaint + 0.5);\n"
+		"#endif\n"
 		"	float scissor = scissorMask(fpos);\n"
 		"#ifdef EDGE_AA\n"
 		"	float strokeAlpha = strokeMask();\n"
@@ -648,6 +769,7 @@ static int glnvg__renderCreate(void* uptr)
 		"#endif\n"
 		"		if (texType == 1) color = vec4(color.xyz*color.w,color.w);"
 		"		if (texType == 2) color = vec4(color.x);"
+		"		if (texType == 3) color = vec4(clamp((color.x - 0.5) / feather + 0.5, 0.0, 1.0));"
 		"		// Apply color tint and alpha.\n"
 		"		color *= innerCol;\n"
 		"		// Combine alpha\n"
@@ -663,8 +785,23 @@ static int glnvg__renderCreate(void* uptr)
 		"#endif\n"
 		"		if (texType == 1) color = vec4(color.xyz*color.w,color.w);"
 		"		if (texType == 2) color = vec4(color.x);"
+		"		if (texType == 3) color = vec4(clamp((color.x - 0.5) / feather + 0.5, 0.0, 1.0));"
 		"		color *= scissor;\n"
 		"		result = color * innerCol;\n"
+		"	} else if (type == 4) {		// Rounded rectangle shape\n"
+		"		// Coverage from the distance to the outline\n"
+		"		vec2 spt = (shapeMat * vec3(fpos,1.0)).xy;\n"
+		"		float sd = sdroundrect(spt, shape.xy, shape.z);\n"
+		"		if (shapeType == 1) sd = abs(sd) - shapeStroke*0.5;\n"
+		"		if (shapeType == 2) sd = -sd;\n"
+		"		float coverage = clamp(0.5 - sd / shape.w, 0.0, 1.0);\n"
+		"		// Calculate gradient color using box gradient\n"
+		"		vec2 pt = (paintMat * vec3(fpos,1.0)).xy;\n"
+		"		float d = clamp((sdroundrect(pt, extent, radius) + feather*0.5) / feather, 0.0, 1.0);\n"
+		"		vec4 color = mix(innerCol,outerCol,d);\n"
+		"		// Combine alpha\n"
+		"		color *= coverage * scissor;\n"
+		"		result = color;\n"
 		"	}\n"
 		"#ifdef NANOVG_GL3\n"
 		"	outColor = result;\n"
@@ -673,15 +810,33 @@ static int glnvg__renderCreate(void* uptr)
 		"#endif\n"
 		"}\n";
 
+	char shaderOpts[64];
+
 	glnvg__checkError(gl, "init");
 
-	if (gl->flags & NVG_ANTIALIAS) {
-		if (glnvg__createShader(&gl->shader, "shader", shaderHeader, "#define EDGE_AA 1\n", fillVertShader, fillFragShader) == 0)
-			return 0;
-	} else {
-		if (glnvg__createShader(&gl->shader, "shader", shaderHeader, NULL, fillVertShader, fillFragShader) == 0)
-			return 0;
+	// Number of paints of a batch, limited by the size of the uniforms
+#if NANOVG_GL_USE_UNIFORMBUFFER
+	// The paints of a batch are read straight from the uniform buffer,
+	// their offsets must match the array stride
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+	gl->fragSize = (GLNVG_PAINT_STRIDE + align - 1) / align * align;
+	gl->maxBatch = gl->fragSize == GLNVG_PAINT_STRIDE ? NANOVG_GL_MAX_BATCH : 1;
+#elif NANOVG_GL_MAX_BATCH > 1
+	{
+		GLint components = 0;
+		glGetIntegerv(GL_MAX_FRAGMENT_UNIFORM_COMPONENTS, &components);
+		gl->maxBatch = components / (NANOVG_GL_UNIFORMARRAY_SIZE * 4);
+		if (gl->maxBatch > NANOVG_GL_MAX_BATCH) gl->maxBatch = NANOVG_GL_MAX_BATCH;
+		if (gl->maxBatch < 1) gl->maxBatch = 1;
 	}
+#else
+	gl->maxBatch = 1;
+#endif
+
+	snprintf(shaderOpts, sizeof(shaderOpts), "%s#define PAINT_COUNT %d\n", (gl->flags & NVG_ANTIALIAS) ? "#define EDGE_AA 1\n" : "", gl->maxBatch);
+
+	if (glnvg__createShader(&gl->shader, "shader", shaderHeader, shaderOpts, fillVertShader, fillFragShader) == 0)
+		return 0;
 
 	glnvg__checkError(gl, "uniform locations");
 	glnvg__getUniforms(&gl->shader);
@@ -691,14 +846,28 @@ static int glnvg__renderCreate(void* uptr)
 	glGenVertexArrays(1, &gl->vertArr);
 #endif
 	glGenBuffers(1, &gl->vertBuf);
+	glGenBuffers(1, &gl->paintBuf);
+	glGenBuffers(1, &gl->indexBuf);
 
 #if NANOVG_GL_USE_UNIFORMBUFFER
 	// Create UBOs
 	glUniformBlockBinding(gl->shader.prog, gl->shader.loc[GLNVG_LOC_FRAG], GLNVG_FRAG_BINDING);
 	glGenBuffers(1, &gl->fragBuf);
-	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
-#endif
+#else
 	gl->fragSize = sizeof(GLNVGfragUniforms) + align - sizeof(GLNVGfragUniforms) % align;
+	gl->batchUniforms = (float*)malloc(sizeof(float) * 4 * NANOVG_GL_UNIFORMARRAY_SIZE * gl->maxBatch);
+	if (gl->batchUniforms == NULL) return 0;
+#endif
+
+#if defined NANOVG_GL3
+	gl->vertStream.target = GL_ARRAY_BUFFER;
+	gl->fragStream.target = GL_UNIFORM_BUFFER;
+	gl->paintStream.target = GL_ARRAY_BUFFER;
+	gl->indexStream.target = GL_ELEMENT_ARRAY_BUFFER;
+#endif
+#if !NANOVG_GL_USE_PERSISTENT_BUFFERS
+	gl->flags &= ~NVG_PERSISTENT_BUFFERS;
+#endif
 
 	glnvg__checkError(gl, "create done");
 
@@ -949,13 +1118,15 @@ static int glnvg__convertPaint(GLNVGcontext* gl, GLNVGfragUniforms* frag, NVGpai
 		if (tex->type == NVG_TEXTURE_RGBA)
 			frag->texType = (tex->flags & NVG_IMAGE_PREMULTIPLIED) ? 0 : 1;
 		else
-			frag->texType = 2;
+			frag->texType = (tex->flags & NVG_IMAGE_SDF) ? 3 : 2;
 		#else
 		if (tex->type == NVG_TEXTURE_RGBA)
 			frag->texType = (tex->flags & NVG_IMAGE_PREMULTIPLIED) ? 0.0f : 1.0f;
 		else
-			frag->texType = 2.0f;
+			frag->texType = (tex->flags & NVG_IMAGE_SDF) ? 3.0f : 2.0f;
 		#endif
+		// Smoothing width of distance field images
+		frag->feather = paint->feather;
 //		printf("frag->texType = %d\n", frag->texType);
 	} else {
 		frag->type = NSVG_SHADER_FILLGRAD;
@@ -971,13 +1142,27 @@ static int glnvg__convertPaint(GLNVGcontext* gl, GLNVGfragUniforms* frag, NVGpai
 
 static GLNVGfragUniforms* nvg__fragUniformPtr(GLNVGcontext* gl, int i);
 
-static void glnvg__setUniforms(GLNVGcontext* gl, int uniformOffset, int image)
+// Sets the paints of the given number of consecutive uniforms, for a batch of calls
+static void glnvg__setBatchUniforms(GLNVGcontext* gl, int uniformOffset, int npaints, int image)
 {
 #if NANOVG_GL_USE_UNIFORMBUFFER
-	glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, gl->fragBuf, uniformOffset, sizeof(GLNVGfragUniforms));
+	// The whole paints array is bound, uploads are padded for the last ones
+	NVG_NOTUSED(npaints);
+	if (gl->flags & NVG_STREAM_BUFFERS)
+		glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, gl->fragStream.buf, gl->fragBase + uniformOffset, GLNVG_PAINT_STRIDE * gl->maxBatch);
+	else
+		glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, gl->fragBuf, uniformOffset, GLNVG_PAINT_STRIDE * gl->maxBatch);
 #else
 	GLNVGfragUniforms* frag = nvg__fragUniformPtr(gl, uniformOffset);
-	glUniform4fv(gl->shader.loc[GLNVG_LOC_FRAG], NANOVG_GL_UNIFORMARRAY_SIZE, &(frag->uniformArray[0][0]));
+	if (npaints == 1) {
+		glUniform4fv(gl->shader.loc[GLNVG_LOC_FRAG], NANOVG_GL_UNIFORMARRAY_SIZE, &(frag->uniformArray[0][0]));
+	} else {
+		int i, size = sizeof(float) * 4 * NANOVG_GL_UNIFORMARRAY_SIZE;
+		for (i = 0; i < npaints; i++)
+			memcpy((unsigned char*)gl->batchUniforms + i * size, nvg__fragUniformPtr(gl, uniformOffset + i * gl->fragSize)->uniformArray, size);
+		glUniform4fv(gl->shader.loc[GLNVG_LOC_FRAG], NANOVG_GL_UNIFORMARRAY_SIZE * npaints, gl->batchUniforms);
+	}
+	NVG_NOTUSED(frag);
 #endif
 
 	if (image != 0) {
@@ -989,6 +1174,11 @@ static void glnvg__setUniforms(GLNVGcontext* gl, int uniformOffset, int image)
 	}
 }
 
+static void glnvg__setUniforms(GLNVGcontext* gl, int uniformOffset, int image)
+{
+	glnvg__setBatchUniforms(gl, uniformOffset, 1, image);
+}
+
 static void glnvg__renderViewport(void* uptr, float width, float height, float devicePixelRatio)
 {
 	NVG_NOTUSED(devicePixelRatio);
@@ -1046,6 +1236,14 @@ static void glnvg__convexFill(GLNVGcontext* gl, GLNVGcall* call)
 	GLNVGpath* paths = &gl->paths[call->pathOffset];
 	int i, npaths = call->pathCount;
 
+	if (call->batchCount > 1) {
+		// Fans and fringes of the whole batch, in drawing order
+		glnvg__setBatchUniforms(gl, call->uniformOffset, call->batchCount, call->image);
+		glnvg__checkError(gl, "convex fill batch");
+		glDrawElements(GL_TRIANGLES, call->indexCount, GL_UNSIGNED_INT, (const GLvoid*)(gl->indexBase + call->indexOffset * sizeof(GLuint)));
+		return;
+	}
+
 	glnvg__setUniforms(gl, call->uniformOffset, call->image);
 	glnvg__checkError(gl, "convex fill");
 
@@ -1107,10 +1305,156 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 
 static void glnvg__triangles(GLNVGcontext* gl, GLNVGcall* call)
 {
-	glnvg__setUniforms(gl, call->uniformOffset, call->image);
+	// Vertices of batched calls are contiguous
+	GLNVGcall* last = call + call->batchCount - 1;
+	int count = last->triangleOffset + last->triangleCount - call->triangleOffset;
+
+	glnvg__setBatchUniforms(gl, call->uniformOffset, call->batchCount, call->image);
 	glnvg__checkError(gl, "triangles fill");
 
-	glDrawArrays(GL_TRIANGLES, call->triangleOffset, call->triangleCount);
+	glDrawArrays(GL_TRIANGLES, call->triangleOffset, count);
+}
+
+// Returns 1 if call b can be drawn in the same batch as call a: same kind of geometry,
+// same texture, same blending and same scissor. Their paints are indexed per vertex.
+static int glnvg__canBatch(GLNVGcontext* gl, GLNVGcall* a, GLNVGcall* b)
+{
+	GLNVGfragUniforms* fa;
+	GLNVGfragUniforms* fb;
+
+	if (a->type != b->type || a->image != b->image)
+		return 0;
+	if (a->type == GLNVG_TRIANGLES) {
+		if (b->triangleOffset != a->triangleOffset + a->triangleCount)
+			return 0;
+	} else if (a->type != GLNVG_CONVEXFILL) {
+		return 0;
+	}
+	// The paints of a batch are read as one array
+	if (b->uniformOffset != a->uniformOffset + gl->fragSize)
+		return 0;
+	if (memcmp(&a->blendFunc, &b->blendFunc, sizeof(GLNVGblend)) != 0)
+		return 0;
+
+	fa = nvg__fragUniformPtr(gl, a->uniformOffset);
+	fb = nvg__fragUniformPtr(gl, b->uniformOffset);
+	return memcmp(fa->scissorMat, fb->scissorMat, sizeof(fa->scissorMat)) == 0 &&
+		memcmp(fa->scissorExt, fb->scissorExt, sizeof(fa->scissorExt)) == 0 &&
+		memcmp(fa->scissorScale, fb->scissorScale, sizeof(fa->scissorScale)) == 0;
+}
+
+// Returns the number of consecutive calls starting at the given one that can be drawn at once.
+static int glnvg__batchSize(GLNVGcontext* gl, int first)
+{
+	int i = first + 1;
+	while (i < gl->ncalls && i - first < gl->maxBatch && glnvg__canBatch(gl, &gl->calls[i-1], &gl->calls[i]))
+		i++;
+	return i - first;
+}
+
+static int glnvg__allocIndices(GLNVGcontext* gl, int n)
+{
+	int ret = 0;
+	if (gl->nindices+n > gl->cindices) {
+		GLuint* indices;
+		int cindices = glnvg__maxi(gl->nindices + n, 4096) + gl->cindices/2; // 1.5x Overallocate
+		indices = (GLuint*)realloc(gl->indices, sizeof(GLuint) * cindices);
+		if (indices == NULL) return -1;
+		gl->indices = indices;
+		gl->cindices = cindices;
+	}
+	ret = gl->nindices;
+	gl->nindices += n;
+	return ret;
+}
+
+static void glnvg__setPaintIndex(GLNVGcontext* gl, int offset, int count, int index)
+{
+	int i;
+	for (i = 0; i < count; i++)
+		gl->paints[offset + i] = (float)index;
+}
+
+// Appends the triangles of a fan (or a strip) starting at the given vertex.
+static void glnvg__appendTriangles(GLuint* dst, int offset, int count, int strip)
+{
+	int i;
+	for (i = 0; i < count - 2; i++) {
+		if (strip) {
+			// Every other triangle of a strip is flipped to keep its winding
+			dst[0] = offset + i + (i & 1);
+			dst[1] = offset + i + 1 - (i & 1);
+			dst[2] = offset + i + 2;
+		} else {
+			dst[0] = offset;
+			dst[1] = offset + i + 1;
+			dst[2] = offset + i + 2;
+		}
+		dst += 3;
+	}
+}
+
+// Sets the convex fill of the given calls as indexed triangles, in drawing order.
+static int glnvg__prepareConvexFillBatch(GLNVGcontext* gl, GLNVGcall* call)
+{
+	int i, j, offset, count = 0;
+
+	for (i = 0; i < call->batchCount; i++) {
+		for (j = 0; j < call[i].pathCount; j++) {
+			GLNVGpath* path = &gl->paths[call[i].pathOffset + j];
+			count += glnvg__maxi(path->fillCount - 2, 0) * 3;
+			count += glnvg__maxi(path->strokeCount - 2, 0) * 3;
+		}
+	}
+
+	offset = glnvg__allocIndices(gl, count);
+	if (offset == -1) return 0;
+
+	call->indexOffset = offset;
+	call->indexCount = count;
+	for (i = 0; i < call->batchCount; i++) {
+		for (j = 0; j < call[i].pathCount; j++) {
+			GLNVGpath* path = &gl->paths[call[i].pathOffset + j];
+			glnvg__setPaintIndex(gl, path->fillOffset, path->fillCount, i);
+			glnvg__appendTriangles(gl->indices + offset, path->fillOffset, path->fillCount, 0);
+			offset += glnvg__maxi(path->fillCount - 2, 0) * 3;
+			// Fringes
+			glnvg__setPaintIndex(gl, path->strokeOffset, path->strokeCount, i);
+			glnvg__appendTriangles(gl->indices + offset, path->strokeOffset, path->strokeCount, 1);
+			offset += glnvg__maxi(path->strokeCount - 2, 0) * 3;
+		}
+	}
+	return 1;
+}
+
+// Groups consecutive calls into batches and writes the paint index of their vertices.
+// Returns the number of batches of more than one call.
+static int glnvg__prepareBatches(GLNVGcontext* gl)
+{
+	int i, j, nbatches = 0;
+
+	gl->nindices = 0;
+	for (i = 0; i < gl->ncalls; i += gl->calls[i].batchCount) {
+		GLNVGcall* call = &gl->calls[i];
+		call->batchCount = glnvg__batchSize(gl, i);
+		if (call->batchCount == 1)
+			continue;
+
+		// Vertices outside of batches use the first paint
+		if (nbatches++ == 0)
+			memset(gl->paints, 0, sizeof(float) * gl->nverts);
+
+		if (call->type == GLNVG_TRIANGLES) {
+			for (j = 0; j < call->batchCount; j++)
+				glnvg__setPaintIndex(gl, call[j].triangleOffset, call[j].triangleCount, j);
+		} else if (!glnvg__prepareConvexFillBatch(gl, call)) {
+			// Out of memory, draw the calls one by one
+			for (j = 0; j < call->batchCount; j++)
+				call[j].batchCount = 1;
+		}
+	}
+
+	return nbatches;
 }
 
 static void glnvg__renderCancel(void* uptr) {
@@ -1165,12 +1509,120 @@ static GLNVGblend glnvg__blendCompositeOperation(NVGcompositeOperationState op)
 	return blend;
 }
 
+#if defined NANOVG_GL3
+// Grows the ring buffer so that the region of one frame can hold the given size.
+static int glnvg__streamReserve(GLNVGcontext* gl, GLNVGstream* stream, int size, int granularity)
+{
+	int frameSize, totalSize;
+
+	if (size <= stream->frameSize)
+		return 1;
+
+	frameSize = glnvg__maxi(size, glnvg__maxi(stream->frameSize * 2, 64 * 1024));
+	frameSize = (frameSize + granularity - 1) / granularity * granularity;
+	totalSize = frameSize * GLNVG_STREAM_FRAMES;
+
+	// The previous buffer stays alive until the GPU is done with it
+	if (stream->buf != 0) {
+		glBindBuffer(stream->target, stream->buf);
+		if (stream->mapped != NULL)
+			glUnmapBuffer(stream->target);
+		glDeleteBuffers(1, &stream->buf);
+	}
+
+	stream->mapped = NULL;
+	stream->frameSize = 0;
+
+	glGenBuffers(1, &stream->buf);
+	glBindBuffer(stream->target, stream->buf);
+
+#if NANOVG_GL_USE_PERSISTENT_BUFFERS
+	if (gl->flags & NVG_PERSISTENT_BUFFERS) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(stream->target, totalSize, NULL, flags);
+		stream->mapped = (unsigned char*)glMapBufferRange(stream->target, 0, totalSize, flags);
+		if (stream->mapped == NULL) {
+			// Fallback to glBufferSubData for good
+			glDeleteBuffers(1, &stream->buf);
+			glGenBuffers(1, &stream->buf);
+			glBindBuffer(stream->target, stream->buf);
+			gl->flags &= ~NVG_PERSISTENT_BUFFERS;
+		}
+	}
+	if (stream->mapped == NULL)
+#endif
+		glBufferData(stream->target, totalSize, NULL, GL_DYNAMIC_DRAW);
+
+	glnvg__checkError(gl, "stream reserve");
+
+	stream->frameSize = frameSize;
+	return 1;
+}
+
+// Copies the given data to the region of the current frame, returns its offset in bytes.
+static int glnvg__streamUpload(GLNVGcontext* gl, GLNVGstream* stream, const void* data, int size, int granularity)
+{
+	int offset;
+
+	glnvg__streamReserve(gl, stream, size, granularity);
+
+	offset = gl->streamFrame * stream->frameSize;
+
+	glBindBuffer(stream->target, stream->buf);
+	if (stream->mapped != NULL)
+		memcpy(stream->mapped + offset, data, size);
+	else
+		glBufferSubData(stream->target, offset, size, data);
+
+	return offset;
+}
+
+static void glnvg__streamWaitFrame(GLNVGcontext* gl)
+{
+	GLsync fence = gl->fences[gl->streamFrame];
+
+	// Wait for the GPU to be done with the region of this frame, it was used GLNVG_STREAM_FRAMES frames ago
+	if (fence != 0) {
+		glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, (GLuint64)1000000000);
+		glDeleteSync(fence);
+		gl->fences[gl->streamFrame] = 0;
+	}
+}
+
+static void glnvg__streamEndFrame(GLNVGcontext* gl)
+{
+	gl->fences[gl->streamFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	gl->streamFrame = (gl->streamFrame + 1) % GLNVG_STREAM_FRAMES;
+}
+
+static void glnvg__streamDelete(GLNVGcontext* gl, GLNVGstream* stream)
+{
+	if (stream->buf == 0)
+		return;
+
+	if (stream->mapped != NULL) {
+		glBindBuffer(stream->target, stream->buf);
+		glUnmapBuffer(stream->target);
+		glBindBuffer(stream->target, 0);
+	}
+
+	glDeleteBuffers(1, &stream->buf);
+	stream->buf = 0;
+	stream->mapped = NULL;
+}
+#endif
+
 static void glnvg__renderFlush(void* uptr)
 {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
-	int i;
+	int i, nbatches;
+	size_t vertBase = 0, paintBase = 0;
+	// Uniforms are uploaded with room for a whole batch of paints after the last one
+	int fragUploadSize = (gl->nuniforms + gl->maxBatch - 1) * gl->fragSize;
 
 	if (gl->ncalls > 0) {
+		nbatches = glnvg__prepareBatches(gl);
+		gl->indexBase = 0;
 
 		// Setup require GL state.
 		glUseProgram(gl->shader.prog);
@@ -1199,32 +1651,66 @@ static void glnvg__renderFlush(void* uptr)
 		gl->blendFunc.dstAlpha = GL_INVALID_ENUM;
 		#endif
 
+#if defined NANOVG_GL3
+		if (gl->flags & NVG_STREAM_BUFFERS) {
+			glnvg__streamWaitFrame(gl);
+
+			// Upload ubo for frag shaders and vertex data in the region of this frame
+			gl->fragBase = glnvg__streamUpload(gl, &gl->fragStream, gl->uniforms, fragUploadSize, gl->fragSize);
+
+			glBindVertexArray(gl->vertArr);
+			if (nbatches > 0) {
+				paintBase = (size_t)glnvg__streamUpload(gl, &gl->paintStream, gl->paints, gl->nverts * sizeof(float), sizeof(float));
+				glEnableVertexAttribArray(2);
+				glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (const GLvoid*)paintBase);
+			}
+			if (gl->nindices > 0)
+				gl->indexBase = (size_t)glnvg__streamUpload(gl, &gl->indexStream, gl->indices, gl->nindices * sizeof(GLuint), sizeof(GLuint));
+			vertBase = (size_t)glnvg__streamUpload(gl, &gl->vertStream, gl->verts, gl->nverts * sizeof(NVGvertex), sizeof(NVGvertex));
+		} else
+#endif
+		{
 #if NANOVG_GL_USE_UNIFORMBUFFER
-		// Upload ubo for frag shaders
-		glBindBuffer(GL_UNIFORM_BUFFER, gl->fragBuf);
-		glBufferData(GL_UNIFORM_BUFFER, gl->nuniforms * gl->fragSize, gl->uniforms, GL_STREAM_DRAW);
+			// Upload ubo for frag shaders
+			glBindBuffer(GL_UNIFORM_BUFFER, gl->fragBuf);
+			glBufferData(GL_UNIFORM_BUFFER, fragUploadSize, gl->uniforms, GL_STREAM_DRAW);
 #endif
 
-		// Upload vertex data
+			// Upload vertex data
 #if defined NANOVG_GL3
-		glBindVertexArray(gl->vertArr);
+			glBindVertexArray(gl->vertArr);
 #endif
-		glBindBuffer(GL_ARRAY_BUFFER, gl->vertBuf);
-		glBufferData(GL_ARRAY_BUFFER, gl->nverts * sizeof(NVGvertex), gl->verts, GL_STREAM_DRAW);
+			if (nbatches > 0) {
+				glBindBuffer(GL_ARRAY_BUFFER, gl->paintBuf);
+				glBufferData(GL_ARRAY_BUFFER, gl->nverts * sizeof(float), gl->paints, GL_STREAM_DRAW);
+				glEnableVertexAttribArray(2);
+				glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (const GLvoid*)0);
+			}
+			if (gl->nindices > 0) {
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl->indexBuf);
+				glBufferData(GL_ELEMENT_ARRAY_BUFFER, gl->nindices * sizeof(GLuint), gl->indices, GL_STREAM_DRAW);
+			}
+			glBindBuffer(GL_ARRAY_BUFFER, gl->vertBuf);
+			glBufferData(GL_ARRAY_BUFFER, gl->nverts * sizeof(NVGvertex), gl->verts, GL_STREAM_DRAW);
+		}
 		glEnableVertexAttribArray(0);
 		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(size_t)0);
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(0 + 2*sizeof(float)));
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)vertBase);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(vertBase + 2*sizeof(float)));
+		// Without batches every vertex uses the first paint
+		if (nbatches == 0)
+			glVertexAttrib1f(2, 0.0f);
 
 		// Set view and texture just once per frame.
 		glUniform1i(gl->shader.loc[GLNVG_LOC_TEX], 0);
 		glUniform2fv(gl->shader.loc[GLNVG_LOC_VIEWSIZE], 1, gl->view);
 
 #if NANOVG_GL_USE_UNIFORMBUFFER
-		glBindBuffer(GL_UNIFORM_BUFFER, gl->fragBuf);
+		if ((gl->flags & NVG_STREAM_BUFFERS) == 0)
+			glBindBuffer(GL_UNIFORM_BUFFER, gl->fragBuf);
 #endif
 
-		for (i = 0; i < gl->ncalls; i++) {
+		for (i = 0; i < gl->ncalls; i += gl->calls[i].batchCount) {
 			GLNVGcall* call = &gl->calls[i];
 			glnvg__blendFuncSeparate(gl,&call->blendFunc);
 			if (call->type == GLNVG_FILL)
@@ -1239,13 +1725,22 @@ static void glnvg__renderFlush(void* uptr)
 
 		glDisableVertexAttribArray(0);
 		glDisableVertexAttribArray(1);
+		glDisableVertexAttribArray(2);
 #if defined NANOVG_GL3
 		glBindVertexArray(0);
 #endif
 		glDisable(GL_CULL_FACE);
 			glBindBuffer(GL_ARRAY_BUFFER, 0);
+#if !defined NANOVG_GL3
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+#endif
 		glUseProgram(0);
 		glnvg__bindTexture(gl, 0);
+
+#if defined NANOVG_GL3
+		if (gl->flags & NVG_STREAM_BUFFERS)
+			glnvg__streamEndFrame(gl);
+#endif
 	}
 
 	// Reset calls
@@ -1303,9 +1798,13 @@ static int glnvg__allocVerts(GLNVGcontext* gl, int n)
 	if (gl->nverts+n > gl->cverts) {
 		NVGvertex* verts;
 		int cverts = glnvg__maxi(gl->nverts + n, 4096) + gl->cverts/2; // 1.5x Overallocate
+		float* paints;
 		verts = (NVGvertex*)realloc(gl->verts, sizeof(NVGvertex) * cverts);
 		if (verts == NULL) return -1;
 		gl->verts = verts;
+		paints = (float*)realloc(gl->paints, sizeof(float) * cverts);
+		if (paints == NULL) return -1;
+		gl->paints = paints;
 		gl->cverts = cverts;
 	}
 	ret = gl->nverts;
@@ -1316,9 +1815,10 @@ static int glnvg__allocVerts(GLNVGcontext* gl, int n)
 static int glnvg__allocFragUniforms(GLNVGcontext* gl, int n)
 {
 	int ret = 0, structSize = gl->fragSize;
-	if (gl->nuniforms+n > gl->cuniforms) {
+	// Keep room for the paints read past the last one by a batch
+	if (gl->nuniforms+n+gl->maxBatch-1 > gl->cuniforms) {
 		unsigned char* uniforms;
-		int cuniforms = glnvg__maxi(gl->nuniforms+n, 128) + gl->cuniforms/2; // 1.5x Overallocate
+		int cuniforms = glnvg__maxi(gl->nuniforms+n+gl->maxBatch-1, 128) + gl->cuniforms/2; // 1.5x Overallocate
 		uniforms = (unsigned char*)realloc(gl->uniforms, structSize * cuniforms);
 		if (uniforms == NULL) return -1;
 		gl->uniforms = uniforms;
@@ -1515,6 +2015,50 @@ error:
 	if (gl->ncalls > 0) gl->ncalls--;
 }
 
+static void glnvg__renderShape(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+								const NVGshape* shape, const NVGvertex* verts, int nverts)
+{
+	GLNVGcontext* gl = (GLNVGcontext*)uptr;
+	GLNVGcall* call = glnvg__allocCall(gl);
+	GLNVGfragUniforms* frag;
+	float invxform[6];
+
+	if (call == NULL) return;
+
+	call->type = GLNVG_TRIANGLES;
+	call->image = 0;
+	call->blendFunc = glnvg__blendCompositeOperation(compositeOperation);
+
+	call->triangleOffset = glnvg__allocVerts(gl, nverts);
+	if (call->triangleOffset == -1) goto error;
+	call->triangleCount = nverts;
+
+	memcpy(&gl->verts[call->triangleOffset], verts, sizeof(NVGvertex) * nverts);
+
+	// Paint as a gradient, covered by the shape
+	call->uniformOffset = glnvg__allocFragUniforms(gl, 1);
+	if (call->uniformOffset == -1) goto error;
+	frag = nvg__fragUniformPtr(gl, call->uniformOffset);
+	glnvg__convertPaint(gl, frag, paint, scissor, 1.0f, 1.0f, -1.0f);
+	frag->type = NSVG_SHADER_SHAPE;
+
+	nvgTransformInverse(invxform, shape->xform);
+	glnvg__xformToMat3x4(frag->shapeMat, invxform);
+	frag->shape[0] = shape->extent[0];
+	frag->shape[1] = shape->extent[1];
+	frag->shape[2] = shape->radius;
+	frag->shape[3] = shape->antialias;
+	frag->shapeStroke = shape->strokeWidth;
+	frag->shapeType = shape->type;
+
+	return;
+
+error:
+	// We get here if call alloc was ok, but something else is not.
+	// Roll back the last call to prevent drawing it.
+	if (gl->ncalls > 0) gl->ncalls--;
+}
+
 static void glnvg__renderDelete(void* uptr)
 {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
@@ -1533,6 +2077,21 @@ static void glnvg__renderDelete(void* uptr)
 #endif
 	if (gl->vertBuf != 0)
 		glDeleteBuffers(1, &gl->vertBuf);
+	if (gl->paintBuf != 0)
+		glDeleteBuffers(1, &gl->paintBuf);
+	if (gl->indexBuf != 0)
+		glDeleteBuffers(1, &gl->indexBuf);
+
+#if defined NANOVG_GL3
+	glnvg__streamDelete(gl, &gl->vertStream);
+	glnvg__streamDelete(gl, &gl->fragStream);
+	glnvg__streamDelete(gl, &gl->paintStream);
+	glnvg__streamDelete(gl, &gl->indexStream);
+	for (i = 0; i < GLNVG_STREAM_FRAMES; i++) {
+		if (gl->fences[i] != 0)
+			glDeleteSync(gl->fences[i]);
+	}
+#endif
 
 	for (i = 0; i < gl->ntextures; i++) {
 		if (gl->textures[i].tex != 0 && (gl->textures[i].flags & NVG_IMAGE_NODELETE) == 0)
@@ -1544,6 +2103,11 @@ static void glnvg__renderDelete(void* uptr)
 	free(gl->verts);
 	free(gl->uniforms);
 	free(gl->calls);
+	free(gl->paints);
+	free(gl->indices);
+#if !NANOVG_GL_USE_UNIFORMBUFFER
+	free(gl->batchUniforms);
+#endif
 
 	free(gl);
 }
@@ -1577,6 +2141,7 @@ NVGcontext* nvgCreateGLES3(int flags)
 	params.renderFill = glnvg__renderFill;
 	params.renderStroke = glnvg__renderStroke;
 	params.renderTriangles = glnvg__renderTriangles;
+	params.renderShape = glnvg__renderShape;
 	params.renderDelete = glnvg__renderDelete;
 	params.userPtr = gl;
 	params.edgeAntiAlias = flags & NVG_ANTIALIAS ? 1 : 0;
@@ -21,6 +21,8 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <atomic>
+
 namespace brls
 {
 
@@ -37,12 +39,22 @@ class GLFWVideoContext : public VideoContext
     void beginFrame() override;
     void endFrame() override;
     void resetState() override;
+    void makeCurrent(bool current) override;
 
     GLFWwindow* getGLFWWindow();
 
+    /**
+     * Sets the framebuffer size, applied to the viewport
+     * at the beginning of the next frame.
+     */
+    void setFramebufferSize(int width, int height);
+
   private:
     GLFWwindow* window     = nullptr;
     NVGcontext* nvgContext = nullptr;
+
+    // Written by the main thread, read by the thread rendering the frames
+    std::atomic<int> framebufferWidth { 0 }, framebufferHeight { 0 };
 };
 
 } // namespace brls
@@ -23,6 +23,7 @@
 
 #include <borealis/core/video.hpp>
 #include <deko3d.hpp>
+#include <atomic>
 #include <nanovg/dk_renderer.hpp>
 #include <optional>
 
@@ -52,6 +53,9 @@ class SwitchVideoContext : public VideoContext
     _LibNXEvent defaultDisplayResolutionChangeEvent;
     bool displayResolutionChangeEventReady = true;
 
+    // Set by the applet callback, the framebuffer is reset by the thread rendering the frames
+    std::atomic<bool> operationModeChanged { false };
+
     void resetFramebuffer(); // triggered by either display resolution change event or operation mode change event
     void updateWindowSize();
     void createFramebufferResources();
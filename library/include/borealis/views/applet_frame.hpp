@@ -32,6 +32,7 @@ class AppletFrame : public Box
     AppletFrame();
 
     void handleXMLElement(tinyxml2::XMLElement* element) override;
+    void handleBXMLElement(BXMLElement element) override;
 
     /**
      * Sets the content view for that AppletFrame.
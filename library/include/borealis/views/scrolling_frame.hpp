@@ -46,7 +46,7 @@ class ScrollingFrame : public Box
     void onChildFocusLost(View* directChild, View* focusedView) override;
     void willAppear(bool resetState) override;
     void addView(View* view) override;
-    void removeView(View* view) override;
+    void removeView(View* view, bool free = true) override;
     void onLayout() override;
     void setPadding(float top, float right, float bottom, float left) override;
     void setPaddingTop(float top) override;
@@ -66,6 +66,13 @@ class ScrollingFrame : public Box
      */
     void setScrollingBehavior(ScrollingBehavior behavior);
 
+    /**
+     * Scrolls the content view by the given amount of pixels, without animation.
+     * Used for analog scrolling: the focus follows the content
+     * so that it never goes off screen.
+     */
+    void scrollBy(float delta);
+
     static View* create();
 
   private:
@@ -73,6 +80,7 @@ class ScrollingFrame : public Box
 
     bool updateScrollingOnNextFrame = false;
     bool childFocused               = false;
+    bool analogScrolling            = false;
 
     float middleY = 0; // y + height/2
     float bottomY = 0; // y + height
@@ -83,6 +91,8 @@ class ScrollingFrame : public Box
     bool updateScrolling(bool animated);
     void startScrolling(bool animated, float newScroll);
     void scrollAnimationTick();
+    void keepFocusOnScreen();
+    View* getNextFocusInContent(FocusDirection direction, View* currentView);
 
     float getScrollingAreaTopBoundary();
     float getScrollingAreaHeight();
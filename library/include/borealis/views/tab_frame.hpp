@@ -18,6 +18,7 @@
 #pragma once
 
 #include <borealis/core/bind.hpp>
+#include <borealis/core/timer.hpp>
 #include <borealis/views/applet_frame.hpp>
 #include <borealis/views/sidebar.hpp>
 #include <functional>
@@ -28,23 +29,62 @@ namespace brls
 typedef std::function<View*(void)> TabViewCreator;
 
 // An applet frame containing a sidebar on the left with multiple tabs which content is showing on the right.
-// Only one tab is kept in memory at all times : when switching, the current tab is freed before the the new one is instantiated.
+// Tabs are instantiated when first shown. When switching, the last shown tabs are kept in a cache
+// instead of being freed, and the neighbours of the current tab are instantiated ahead of time while
+// the user isn't switching tabs, so that moving through the sidebar doesn't instantiate a tab at every step.
 class TabFrame : public AppletFrame
 {
   public:
     TabFrame();
+    ~TabFrame();
 
     void handleXMLElement(tinyxml2::XMLElement* element) override;
+    void handleBXMLElement(BXMLElement element) override;
 
     void addTab(std::string label, TabViewCreator creator);
     void addSeparator();
 
+    /**
+     * Sets the number of hidden tabs kept in memory, the least recently
+     * shown ones being freed first. Set to 0 to free tabs as soon as they are hidden.
+     */
+    void setTabCacheSize(unsigned size);
+
+    /**
+     * Enables or disables the instantiation of the neighbours of the current
+     * tab when idle. The preloaded tabs are kept in the tab cache.
+     */
+    void setTabPreloadingEnabled(bool enabled);
+
     static View* create();
 
   private:
     BRLS_BIND(Sidebar, sidebar, "brls/tab_frame/sidebar");
 
-    View* activeTab = nullptr;
+    struct Tab
+    {
+        TabViewCreator creator;
+        View* view = nullptr; // instantiated but hidden, in the cache
+    };
+
+    std::vector<Tab> tabs;
+    std::vector<size_t> cachedTabs; // least recently shown first
+
+    View* activeTab           = nullptr;
+    size_t activeTabIndex     = 0;
+    int lastDirection         = 1; // 1 towards the end of the sidebar, -1 towards the beginning
+    unsigned tabCacheSize     = 0;
+    bool tabPreloadingEnabled = true;
+
+    Timer preloadTimer;
+
+    void showTab(size_t index);
+    void cacheTab(size_t index, View* view);
+    View* takeCachedTab(size_t index);
+    void trimTabCache();
+
+    void schedulePreload();
+    bool preloadNextTab();
 };
 
 } // namespace brls
@@ -54,6 +54,72 @@ View* Activity::createContentView()
     return nullptr;
 }
 
+BXMLDocument* Activity::getContentBXML()
+{
+    return nullptr;
+}
+
+bool Activity::prepareStep()
+{
+    if (this->prepared)
+        return true;
+
+    ViewArenaScope arenaScope(this->viewArena);
+
+    // First step: create the content view, or only the root view of its compiled layout
+    if (!this->pendingContentView)
+    {
+        BXMLDocument* document = this->getContentBXML();
+
+        if (!document)
+        {
+            this->setContentView(this->createContentView());
+            this->onContentAvailable();
+
+            this->prepared = true;
+            return true;
+        }
+
+        BXMLElement root = document->getRootElement();
+
+        this->pendingContentView  = View::instantiateBXMLElement(root);
+        this->pendingElement      = root.getFirstChild();
+        this->pendingElementIndex = 0;
+
+        return false;
+    }
+
+    // Next steps: one top-level element at a time
+    if (this->pendingElement.isValid())
+    {
+        this->pendingContentView->handleBXMLChild(this->pendingElement, this->pendingElementIndex++);
+        this->pendingElement = this->pendingElement.getNextSibling();
+
+        return false;
+    }
+
+    // Last step: the whole tree is there, setting it sizes it to the window and lays it out
+    this->setContentView(this->pendingContentView);
+    this->pendingContentView = nullptr;
+
+    this->onContentAvailable();
+
+    this->prepared = true;
+    return true;
+}
+
+void Activity::prepare()
+{
+    // Finish what preloading didn't do yet
+    while (!this->prepared)
+        this->prepareStep();
+}
+
+bool Activity::isPrepared()
+{
+    return this->prepared;
+}
+
 float Activity::getShowAnimationDuration(TransitionAnimation animation)
 {
     Style style = Application::getStyle();
@@ -164,8 +230,34 @@ View* Activity::getView(std::string id)
     return this->contentView->getView(id);
 }
 
+void Activity::setViewArenaEnabled(bool enabled)
+{
+    if (enabled && !this->viewArena)
+    {
+        this->viewArena = new ViewArena();
+    }
+    else if (!enabled && this->viewArena)
+    {
+        if (this->contentView)
+            fatal("Cannot disable the view arena of an activity once its content view is created");
+
+        delete this->viewArena;
+        this->viewArena = nullptr;
+    }
+}
+
+ViewArena* Activity::getViewArena()
+{
+    return this->viewArena;
+}
+
 Activity::~Activity()
 {
+    Application::cancelActivityPreloading(this);
+
+    if (this->pendingContentView)
+        delete this->pendingContentView;
+
     if (this->contentView)
     {
         this->contentView->willDisappear();
@@ -173,6 +265,10 @@ Activity::~Activity()
         delete this->contentView;
         this->contentView = nullptr;
     }
+
+    // Only release the arena once all views are deleted
+    if (this->viewArena)
+        delete this->viewArena;
 }
 
 } // namespace brls
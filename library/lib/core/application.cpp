@@ -24,12 +24,16 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/shape_cache.hpp>
+#include <borealis/core/spatial_focus.hpp>
 #include <borealis/core/time.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/views/button.hpp>
 #include <borealis/views/header.hpp>
 #include <borealis/views/image.hpp>
+#include <borealis/views/label.hpp>
 #include <borealis/views/rectangle.hpp>
+#include <borealis/views/scrolling_frame.hpp>
 #include <borealis/views/sidebar.hpp>
 #include <borealis/views/tab_frame.hpp>
 #include <stdexcept>
@@ -40,6 +44,7 @@
 #endif
 
 #include <chrono>
+#include <cmath>
 #include <set>
 #include <thread>
 
@@ -51,11 +56,45 @@ constexpr uint32_t ORIGINAL_WINDOW_HEIGHT = 720;
 #define BUTTON_REPEAT_DELAY 15
 #define BUTTON_REPEAT_CADENCY 5
 
+// Analog sticks: deflection under the deadzone is ignored, the rest goes through
+// a quadratic speed curve to get the navigation repeat period and the scrolling speed
+#define ANALOG_DEADZONE 0.2f
+#define ANALOG_NAVIGATION_SLOWEST_PERIOD 400000 // in us, right after the deadzone
+#define ANALOG_NAVIGATION_FASTEST_PERIOD 50000 // in us, at full deflection
+#define ANALOG_SCROLLING_MAX_SPEED 2000.0f // in pixels per second, at full deflection
+
+// Time given every frame to create the content of preloaded activities, in us
+// At least one step is always made every frame, regardless of the budget
+#define ACTIVITY_PRELOAD_FRAME_BUDGET 4000
+
+using namespace brls::literals;
+
 namespace brls
 {
 
+// Shown by pushActivityWhenReady() while the content of the activity is being created
+class LoadingActivity : public Activity
+{
+  public:
+    View* createContentView() override
+    {
+        Box* box = new Box();
+        box->setJustifyContent(JustifyContent::CENTER);
+        box->setAlignItems(AlignItems::CENTER);
+
+        Label* label = new Label();
+        label->setText("brls/loading_activity/text"_i18n);
+        box->addView(label);
+
+        return box;
+    }
+};
+
 bool Application::init()
 {
+    // Write the logs from a separate thread from now on
+    Logger::setAsynchronous(true);
+
     // Init platform
     Application::platform = Platform::createPlatform();
 
@@ -112,10 +151,20 @@ void Application::createWindow(std::string windowTitle)
             return;
 
         if (eventType == yoga::Event::NodeLayout)
+        {
             view->onLayout();
+
+            if (view->getSpatialFocusIndex())
+                view->getSpatialFocusIndex()->invalidate(view);
+        }
     });
 
     // Load fonts and setup fallbacks
+    if (Application::textSDFEnabled)
+        nvgTextSDF(Application::getNVGContext(), 1);
+
+    Application::updateRenderThread();
+
     Application::platform->getFontLoader()->loadFonts();
 
     int regular = Application::getFont(FONT_REGULAR);
@@ -142,6 +191,8 @@ void Application::createWindow(std::string windowTitle)
         Logger::warning("Regular font was not loaded, there will be no text displayed in the app");
     }
 
+    FontLoader::loadGlyphCache();
+
     // Register built-in XML views
     Application::registerBuiltInXMLViews();
 }
@@ -157,6 +208,10 @@ bool Application::mainLoop()
         return false;
     }
 
+    // Events forwarded by the render thread
+    if (Application::renderThread)
+        Application::renderThread->runMainThreadTasks();
+
     // Input
     ControllerState controllerState = {};
 
@@ -192,6 +247,8 @@ bool Application::mainLoop()
 
     oldControllerState = controllerState;
 
+    Application::processAnalogInputs(&controllerState);
+
     // Animations
     updateHighlightAnimation();
     Ticking::updateTickings();
@@ -199,6 +256,9 @@ bool Application::mainLoop()
     // Render
     Application::frame();
 
+    // Preloading, after rendering to not delay this frame
+    Application::preloadActivities();
+
     return true;
 }
 
@@ -217,6 +277,85 @@ void Application::quit()
     Application::quitRequested = true;
 }
 
+// Applies the deadzone and the speed curve to the given axis value
+// Returns the "speed" between 0.0f and 1.0f, or 0.0f if the stick is in the deadzone
+static float getAnalogSpeed(float value)
+{
+    float deflection = std::min(std::abs(value), 1.0f);
+
+    if (deflection < ANALOG_DEADZONE)
+        return 0.0f;
+
+    float speed = (deflection - ANALOG_DEADZONE) / (1.0f - ANALOG_DEADZONE);
+    return speed * speed;
+}
+
+void Application::processAnalogInputs(ControllerState* state)
+{
+    static Time lastFrameTime      = 0;
+    static Time lastNavigationTime = 0;
+    static int navigationButton    = _BUTTON_MAX; // _BUTTON_MAX if the left stick is idle
+
+    Time now   = getCPUTimeUsec();
+    Time delta = lastFrameTime == 0 ? 0 : now - lastFrameTime;
+
+    lastFrameTime = now;
+
+    // Left stick: focus navigation, the dominant axis gives the direction
+    float x = state->axes[LEFT_X];
+    float y = state->axes[LEFT_Y];
+
+    if (std::max(std::abs(x), std::abs(y)) < ANALOG_DEADZONE)
+    {
+        navigationButton = _BUTTON_MAX;
+    }
+    else
+    {
+        int button;
+        if (std::abs(x) > std::abs(y))
+            button = x > 0.0f ? BUTTON_RIGHT : BUTTON_LEFT;
+        else
+            button = y > 0.0f ? BUTTON_DOWN : BUTTON_UP;
+
+        // First move is immediate, then repeat faster as the stick goes further
+        if (button != navigationButton)
+        {
+            navigationButton   = button;
+            lastNavigationTime = now;
+            Application::onControllerButtonPressed((enum ControllerButton)button, false);
+        }
+        else
+        {
+            float speed = getAnalogSpeed(std::abs(x) > std::abs(y) ? x : y);
+            Time period = ANALOG_NAVIGATION_SLOWEST_PERIOD - (Time)(speed * (ANALOG_NAVIGATION_SLOWEST_PERIOD - ANALOG_NAVIGATION_FASTEST_PERIOD));
+
+            if (now - lastNavigationTime >= period)
+            {
+                lastNavigationTime = now;
+                Application::onControllerButtonPressed((enum ControllerButton)button, true);
+            }
+        }
+    }
+
+    // Right stick: continuous scrolling of the nearest scrolling frame
+    float scrollSpeed = getAnalogSpeed(state->axes[RIGHT_Y]);
+
+    if (scrollSpeed == 0.0f || delta == 0 || Application::blockInputsTokens != 0 || !Application::currentFocus)
+        return;
+
+    for (View* view = Application::currentFocus; view->hasParent(); view = view->getParent())
+    {
+        ScrollingFrame* scrollingFrame = dynamic_cast<ScrollingFrame*>(view->getParent());
+
+        if (scrollingFrame)
+        {
+            float direction = state->axes[RIGHT_Y] > 0.0f ? 1.0f : -1.0f;
+            scrollingFrame->scrollBy(direction * scrollSpeed * ANALOG_SCROLLING_MAX_SPEED * delta / 1000000.0f);
+            break;
+        }
+    }
+}
+
 void Application::navigate(FocusDirection direction)
 {
     View* currentFocus = Application::currentFocus;
@@ -234,7 +373,7 @@ void Application::navigate(FocusDirection direction)
         nextFocus = currentFocus->getCustomNavigationRoutePtr(direction);
 
         if (!nextFocus)
-            Logger::warning("Tried to follow a navigation route that leads to a nullptr view! (from=\"" + currentFocus->describe() + "\", direction=" + std::to_string((int)direction) + ")");
+            BRLS_LOG_WARNING("Tried to follow a navigation route that leads to a nullptr view! (from=\"{}\", direction={})", currentFocus->describe(), (int)direction);
     }
     // By ID
     else if (currentFocus->hasCustomNavigationRouteById(direction))
@@ -243,7 +382,7 @@ void Application::navigate(FocusDirection direction)
         nextFocus      = currentFocus->getNearestView(id);
 
         if (!nextFocus)
-            Logger::warning("Tried to follow a navigation route that leads to an unknown view ID! (from=\"" + currentFocus->describe() + "\", direction=" + std::to_string((int)direction) + ", targetId=\"" + id + "\")");
+            BRLS_LOG_WARNING("Tried to follow a navigation route that leads to an unknown view ID! (from=\"{}\", direction={}, targetId=\"{}\")", currentFocus->describe(), (int)direction, id);
     }
     // Do nothing if current focus doesn't have a parent
     // (in which case there is nothing to traverse)
@@ -280,7 +419,7 @@ void Application::onControllerButtonPressed(enum ControllerButton button, bool r
 {
     if (Application::blockInputsTokens != 0)
     {
-        Logger::debug("{} button press blocked (tokens={})", button, Application::blockInputsTokens);
+        BRLS_LOG_DEBUG("{} button press blocked (tokens={})", button, Application::blockInputsTokens);
         return;
     }
 
@@ -377,14 +516,23 @@ void Application::frame()
     frameContext.fontStash  = &Application::fontStash;
     frameContext.theme      = Application::getTheme();
 
-    // Begin frame and clear
+    // Begin frame and clear, done by the render thread when there is one
     NVGcolor backgroundColor = frameContext.theme["brls/background"];
-    videoContext->beginFrame();
-    videoContext->clear(backgroundColor);
+    if (!Application::renderThread)
+    {
+        videoContext->beginFrame();
+        videoContext->clear(backgroundColor);
+    }
 
     nvgBeginFrame(Application::getNVGContext(), Application::windowWidth, Application::windowHeight, frameContext.pixelRatio);
     nvgScale(Application::getNVGContext(), Application::windowScale, Application::windowScale);
 
+    // Rasterize some of the pending glyphs
+    GlyphPrewarmer::frame();
+
+    // Evict the shapes that were not drawn recently
+    ShapeCache::frame();
+
     std::vector<View*> viewsToDraw;
 
     // Draw all activities in the stack
@@ -409,18 +557,142 @@ void Application::frame()
 
     // End frame
     nvgResetTransform(Application::getNVGContext()); // scale
-    nvgEndFrame(Application::getNVGContext());
 
-    Application::platform->getVideoContext()->endFrame();
+    if (Application::renderThread)
+    {
+        // Waits for the render thread if too many frames are queued
+        NVGframe* frame = Application::renderThread->acquireFrame();
+        nvgEndFrameDeferred(Application::getNVGContext(), frame);
+        Application::renderThread->submitFrame(frame, backgroundColor);
+    }
+    else
+    {
+        nvgEndFrame(Application::getNVGContext());
+        videoContext->endFrame();
+    }
 }
 
 void Application::exit()
 {
     Logger::info("Exiting...");
 
+    FontLoader::saveGlyphCache();
+
     Application::clear();
 
+    // Submit the last frames and take the graphics context back
+    delete Application::renderThread;
+    Application::renderThread = nullptr;
+
+    ShapeCache::clear();
+
+    // Stop the tessellation threads
+    nvgSetDispatcher(Application::getNVGContext(), nullptr, nullptr, 0);
+    delete Application::tessellationPool;
+    Application::tessellationPool = nullptr;
+
     delete Application::platform;
+
+    Logger::setAsynchronous(false);
+}
+
+void Application::setTextSDFEnabled(bool enabled)
+{
+    Application::textSDFEnabled = enabled;
+
+    // Window is already created
+    if (Application::platform && Application::platform->getVideoContext())
+        nvgTextSDF(Application::getNVGContext(), enabled ? 1 : 0);
+}
+
+bool Application::isTextSDFEnabled()
+{
+    return Application::textSDFEnabled;
+}
+
+static void dispatchTessellation(void* userPtr, NVGjobFunction job, void* jobPtr, int njobs)
+{
+    ThreadPool* pool = (ThreadPool*)userPtr;
+    pool->parallelFor(njobs, [job, jobPtr](size_t index) { job(jobPtr, (int)index); });
+}
+
+static void dispatchSequential(void* userPtr, NVGjobFunction job, void* jobPtr, int njobs)
+{
+    for (int i = 0; i < njobs; i++)
+        job(jobPtr, i);
+}
+
+void Application::setTessellationThreads(unsigned threads)
+{
+    Application::tessellationThreads = threads;
+
+    // Window is already created
+    if (Application::platform && Application::platform->getVideoContext())
+        Application::updateTessellationPool();
+}
+
+unsigned Application::getTessellationThreads()
+{
+    return Application::tessellationThreads;
+}
+
+void Application::updateTessellationPool()
+{
+    // The dispatcher is used by the render thread when submitting the frames
+    if (Application::renderThread && !Application::renderThread->isRenderThread())
+    {
+        Application::renderThread->runSync(Application::updateTessellationPool);
+        return;
+    }
+
+    NVGcontext* vg = Application::getNVGContext();
+
+    nvgSetDispatcher(vg, nullptr, nullptr, 0);
+
+    if (Application::tessellationPool)
+    {
+        delete Application::tessellationPool;
+        Application::tessellationPool = nullptr;
+    }
+
+    if (Application::tessellationThreads > 1)
+    {
+        Application::tessellationPool = new ThreadPool(Application::tessellationThreads - 1);
+        nvgSetDispatcher(vg, dispatchTessellation, Application::tessellationPool, Application::tessellationThreads);
+    }
+    else if (Application::renderThread)
+    {
+        // Paths still need to be recorded to be tessellated by the render thread
+        nvgSetDispatcher(vg, dispatchSequential, nullptr, 1);
+    }
+}
+
+void Application::setRenderPipelineDepth(unsigned frames)
+{
+    Application::renderPipelineDepth = std::min(frames, 2u);
+
+    // Window is already created
+    if (Application::platform && Application::platform->getVideoContext())
+        Application::updateRenderThread();
+}
+
+unsigned Application::getRenderPipelineDepth()
+{
+    return Application::renderPipelineDepth;
+}
+
+void Application::updateRenderThread()
+{
+    if (Application::renderThread)
+    {
+        delete Application::renderThread;
+        Application::renderThread = nullptr;
+    }
+
+    if (Application::renderPipelineDepth > 0)
+        Application::renderThread = new RenderThread(Application::platform->getVideoContext(), Application::renderPipelineDepth);
+
+    Application::updateTessellationPool();
 }
 
 void Application::setDisplayFramerate(bool enabled)
@@ -484,7 +756,7 @@ void Application::giveFocus(View* view)
         if (newFocus)
         {
             newFocus->onFocusGained();
-            Logger::debug("Giving focus to {}", newFocus->describe());
+            BRLS_LOG_DEBUG("Giving focus to {}", newFocus->describe());
         }
     }
 }
@@ -543,7 +815,7 @@ void Application::popActivity(TransitionAnimation animation, std::function<void(
     {
         View* newFocus = Application::focusStack[Application::focusStack.size() - 1];
 
-        Logger::debug("Giving focus to {}, and removing it from the focus stack", newFocus->describe());
+        BRLS_LOG_DEBUG("Giving focus to {}, and removing it from the focus stack", newFocus->describe());
 
         Application::giveFocus(newFocus);
         Application::focusStack.pop_back();
@@ -554,9 +826,9 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
 {
     Application::blockInputs();
 
-    // Create the activity content view
-    activity->setContentView(activity->createContentView());
-    activity->onContentAvailable();
+    // Create the activity content view, or finish creating it if it's being preloaded
+    Application::cancelActivityPreloading(activity);
+    activity->prepare();
 
     // Call hide() on the previous activity in the stack if no
     // activities are translucent, then call show() once the animation ends
@@ -567,12 +839,6 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
     bool fadeOut = last && !last->isTranslucent() && !activity->isTranslucent(); // play the fade out animation?
     bool wait    = animation == TransitionAnimation::FADE; // wait for the old activity animation to be done before showing the new one?
 
-    if (Application::globalQuitEnabled)
-        Application::gloablQuitIdentifier = activity->registerExitAction();
-
-    if (Application::globalFPSToggleEnabled)
-        Application::gloablFPSToggleIdentifier = Application::registerFPSToggleAction(activity);
-
     // Fade out animation
     if (fadeOut)
     {
@@ -599,8 +865,6 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
             true, last->getShowAnimationDuration(animation));
     }
 
-    activity->resizeToFitWindow();
-
     if (!fadeOut)
         activity->show([] { Application::unblockInputs(); }, true, activity->getShowAnimationDuration(animation));
     else
@@ -609,16 +873,128 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
     // Focus
     if (Application::activitiesStack.size() > 0 && Application::currentFocus != nullptr)
     {
-        Logger::debug("Pushing {} to the focus stack", Application::currentFocus->describe());
+        BRLS_LOG_DEBUG("Pushing {} to the focus stack", Application::currentFocus->describe());
         Application::focusStack.push_back(Application::currentFocus);
     }
 
+    // And push it
+    Application::activitiesStack.push_back(activity);
+    Application::enterActivity(activity);
+}
+
+void Application::enterActivity(Activity* activity)
+{
+    if (Application::globalQuitEnabled)
+        Application::gloablQuitIdentifier = activity->registerExitAction();
+
+    if (Application::globalFPSToggleEnabled)
+        Application::gloablFPSToggleIdentifier = Application::registerFPSToggleAction(activity);
+
     // Layout and prepare activity
+    activity->resizeToFitWindow();
     activity->willAppear(true);
-    Application::giveFocus(activity->getDefaultFocus());
 
-    // And push it
-    Application::activitiesStack.push_back(activity);
+    if (Application::activitiesStack.back() == activity)
+        Application::giveFocus(activity->getDefaultFocus());
+}
+
+void Application::preloadActivity(Activity* activity)
+{
+    if (activity->isPrepared())
+        return;
+
+    for (PreloadingActivity& preloading : Application::preloadingActivities)
+    {
+        if (preloading.activity == activity)
+            return;
+    }
+
+    Application::preloadingActivities.push_back({ activity, nullptr, TransitionAnimation::FADE });
+}
+
+void Application::pushActivityWhenReady(Activity* activity, TransitionAnimation animation)
+{
+    if (activity->isPrepared())
+    {
+        Application::pushActivity(activity, animation);
+        return;
+    }
+
+    Activity* placeholder = new LoadingActivity();
+    Application::pushActivity(placeholder, animation);
+
+    // The pushed activity goes first, before the ones only preloaded
+    Application::cancelActivityPreloading(activity);
+    Application::preloadingActivities.insert(Application::preloadingActivities.begin(), { activity, placeholder, animation });
+}
+
+void Application::cancelActivityPreloading(Activity* activity)
+{
+    for (auto it = Application::preloadingActivities.begin(); it != Application::preloadingActivities.end(); ++it)
+    {
+        if (it->activity == activity)
+        {
+            Application::preloadingActivities.erase(it);
+            return;
+        }
+
+        // The loading activity was popped, the activity will never be shown
+        if (it->placeholder == activity)
+        {
+            Activity* orphan = it->activity;
+            Application::preloadingActivities.erase(it);
+            delete orphan;
+            return;
+        }
+    }
+}
+
+void Application::preloadActivities()
+{
+    Time start = getCPUTimeUsec();
+
+    while (!Application::preloadingActivities.empty())
+    {
+        PreloadingActivity preloading = Application::preloadingActivities[0];
+
+        if (preloading.activity->prepareStep())
+        {
+            // Wait for the loading activity transition to end before replacing it
+            if (preloading.placeholder && Application::blockInputsTokens > 0)
+                break;
+
+            Application::preloadingActivities.erase(Application::preloadingActivities.begin());
+
+            if (preloading.placeholder)
+                Application::replacePlaceholderActivity(preloading.placeholder, preloading.activity, preloading.animation);
+        }
+
+        if (getCPUTimeUsec() - start >= ACTIVITY_PRELOAD_FRAME_BUDGET)
+            break;
+    }
+}
+
+void Application::replacePlaceholderActivity(Activity* placeholder, Activity* activity, TransitionAnimation animation)
+{
+    auto it = std::find(Application::activitiesStack.begin(), Application::activitiesStack.end(), placeholder);
+
+    if (it == Application::activitiesStack.end())
+    {
+        delete activity;
+        return;
+    }
+
+    placeholder->willDisappear(true);
+
+    *it = activity;
+    Application::enterActivity(activity);
+
+    // Fade the activity in over the loading activity
+    Application::blockInputs();
+    activity->hide([] {}, false, 0.0f);
+    activity->show([] { Application::unblockInputs(); }, true, activity->getShowAnimationDuration(animation));
+
+    delete placeholder;
 }
 
 void Application::clear()
@@ -686,7 +1062,7 @@ void Application::crash(std::string text)
 void Application::blockInputs()
 {
     Application::blockInputsTokens += 1;
-    Logger::debug("Adding an inputs block token (tokens={})", Application::blockInputsTokens);
+    BRLS_LOG_DEBUG("Adding an inputs block token (tokens={})", Application::blockInputsTokens);
 }
 
 void Application::unblockInputs()
@@ -694,7 +1070,7 @@ void Application::unblockInputs()
     if (Application::blockInputsTokens > 0)
         Application::blockInputsTokens -= 1;
 
-    Logger::debug("Removing an inputs block token (tokens={})", Application::blockInputsTokens);
+    BRLS_LOG_DEBUG("Removing an inputs block token (tokens={})", Application::blockInputsTokens);
 }
 
 NVGcontext* Application::getNVGContext()
@@ -714,6 +1090,13 @@ std::string* Application::getCommonFooter()
 
 void Application::onWindowResized(int width, int height)
 {
+    // The video context of the render thread noticed the change
+    if (Application::renderThread && Application::renderThread->isRenderThread())
+    {
+        Application::renderThread->postToMainThread([width, height] { Application::onWindowResized(width, height); });
+        return;
+    }
+
     Application::windowWidth  = width;
     Application::windowHeight = height;
 
@@ -729,7 +1112,7 @@ void Application::onWindowResized(int width, int height)
     Logger::info("New scale factor is {}", Application::windowScale);
 
     // Trigger a layout
-    Logger::debug("Layout triggered");
+    BRLS_LOG_DEBUG("Layout triggered");
 
     for (Activity* activity : Application::activitiesStack)
         activity->onWindowSizeChanged();
@@ -750,6 +1133,11 @@ VoidEvent* Application::getGlobalHintsUpdateEvent()
     return &Application::globalHintsUpdateEvent;
 }
 
+FontStash* Application::getFontStash()
+{
+    return &Application::fontStash;
+}
+
 int Application::getFont(std::string fontName)
 {
     if (Application::fontStash.count(fontName) == 0)
@@ -18,6 +18,7 @@
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/spatial_focus.hpp>
 #include <borealis/core/util.hpp>
 #include <cmath>
 
@@ -103,6 +104,11 @@ Box::Box(Axis axis)
     this->registerFloatXMLAttribute("padding", [this](float value) {
         this->setPadding(value);
     });
+
+    // Spatial navigation
+    this->registerBoolXMLAttribute("spatialNavigation", [this](bool value) {
+        this->setSpatialNavigation(value);
+    });
 }
 
 Box::Box()
@@ -111,6 +117,15 @@ Box::Box()
     // Empty ctor for XML
 }
 
+Box::~Box()
+{
+    for (View* child : this->children)
+        delete child;
+
+    if (this->spatialNavigationIndex)
+        delete this->spatialNavigationIndex;
+}
+
 void Box::getCullingBounds(float* top, float* right, float* bottom, float* left)
 {
     *top    = this->getY();
@@ -161,63 +176,82 @@ void Box::draw(NVGcontext* vg, float x, float y, float width, float height, Styl
 
 void Box::addView(View* view)
 {
-    size_t position = YGNodeGetChildCount(this->ygNode);
-    this->addView(view, position);
+    this->addView(view, this->children.size());
 }
 
 void Box::addView(View* view, size_t position)
 {
+    if (position > this->children.size())
+        fatal("Cannot add view " + view->describe() + " at position " + std::to_string(position) + " in " + this->describe() + ": out of bounds");
+
     // Add the view to our children and YGNode
     this->children.insert(this->children.begin() + position, view);
 
     if (!view->isDetached())
-        YGNodeInsertChild(this->ygNode, view->getYGNode(), position);
+    {
+        // Detached children are not in the YGNode, skip them to find the YGNode position
+        size_t ygPosition = 0;
+        for (size_t i = 0; i < position; i++)
+        {
+            if (!this->children[i]->isDetached())
+                ygPosition++;
+        }
+
+        YGNodeInsertChild(this->ygNode, view->getYGNode(), ygPosition);
+    }
+
+    view->setParent(this, position);
+
+    // Shift the index of the next children
+    for (size_t i = position + 1; i < this->children.size(); i++)
+        this->children[i]->setParentIndex(i);
 
-    // Allocate and set parent userdata
-    size_t* userdata = (size_t*)malloc(sizeof(size_t));
-    *userdata        = position;
+    // Register the view in the spatial focus index, if any
+    SpatialFocusIndex* index = this->spatialNavigationIndex ? this->spatialNavigationIndex : this->getSpatialFocusIndex();
 
-    view->setParent(this, userdata);
+    if (index)
+        index->add(view);
 
     // Layout and events
     this->invalidate();
     view->willAppear();
 }
 
-void Box::removeView(View* view)
+void Box::removeView(View* view, bool free)
 {
-    if (!view)
+    if (!view || view->getParent() != this)
         return;
 
-    // Find the index of the view
-    size_t index;
-    bool found = false;
+    size_t position = view->getParentIndex();
 
-    for (size_t i = 0; i < this->children.size(); i++)
-    {
-        View* child = this->children[i];
+    // Remove it
+    if (!view->isDetached())
+        YGNodeRemoveChild(this->ygNode, view->getYGNode());
 
-        if (child == view)
-        {
-            found = true;
-            index = i;
-            break;
-        }
-    }
+    this->children.erase(this->children.begin() + position);
 
-    if (!found)
-        return;
+    // Shift the index of the next children
+    for (size_t i = position; i < this->children.size(); i++)
+        this->children[i]->setParentIndex(i);
 
-    // Remove it
-    YGNodeRemoveChild(this->ygNode, view->getYGNode());
-    this->children.erase(this->children.begin() + index);
+    if (view->getSpatialFocusIndex())
+        view->getSpatialFocusIndex()->remove(view);
 
     view->willDisappear(true);
-    delete view;
+    view->setParent(nullptr);
+
+    if (free)
+        delete view;
 
     this->invalidate();
 }
 
+void Box::removeViewAt(size_t position)
+{
+    if (position < this->children.size())
+        this->removeView(this->children[position]);
+}
+
 void Box::onFocusGained()
 {
     View::onFocusGained();
@@ -318,7 +352,17 @@ View* Box::getDefaultFocus()
 
 View* Box::getNextFocus(FocusDirection direction, View* currentView)
 {
-    void* parentUserData = currentView->getParentUserData();
+    // Spatial navigation: the index resolves the focus for the whole subtree,
+    // so boxes inside of it leave the decision to the spatial navigation box
+    if (this->spatialNavigationIndex)
+    {
+        View* currentFocus = Application::getCurrentFocus();
+        return this->spatialNavigationIndex->getNextFocus(direction, currentFocus ? currentFocus : currentView);
+    }
+    else if (this->getSpatialFocusIndex())
+    {
+        return nullptr;
+    }
 
     // Return nullptr immediately if focus direction mismatches the box axis (clang-format refuses to split it in multiple lines...)
     if ((this->axis == Axis::ROW && direction != FocusDirection::LEFT && direction != FocusDirection::RIGHT) || (this->axis == Axis::COLUMN && direction != FocusDirection::UP && direction != FocusDirection::DOWN))
@@ -334,7 +378,7 @@ View* Box::getNextFocus(FocusDirection direction, View* currentView)
         offset = -1;
     }
 
-    size_t currentFocusIndex = *((size_t*)parentUserData) + offset;
+    size_t currentFocusIndex = currentView->getParentIndex() + offset;
     View* currentFocus       = nullptr;
 
     while (!currentFocus && currentFocusIndex >= 0 && currentFocusIndex < this->children.size())
@@ -364,6 +408,37 @@ void Box::onWindowSizeChanged()
         child->onWindowSizeChanged();
 }
 
+void Box::setSpatialNavigation(bool enabled)
+{
+    if (enabled == this->hasSpatialNavigation())
+        return;
+
+    if (enabled)
+    {
+        this->spatialNavigationIndex = new SpatialFocusIndex(this);
+
+        for (View* child : this->children)
+            this->spatialNavigationIndex->add(child);
+    }
+    else
+    {
+        delete this->spatialNavigationIndex;
+        this->spatialNavigationIndex = nullptr;
+
+        // Give the children back to the parent index, if any
+        if (this->getSpatialFocusIndex())
+        {
+            for (View* child : this->children)
+                this->getSpatialFocusIndex()->add(child);
+        }
+    }
+}
+
+bool Box::hasSpatialNavigation()
+{
+    return this->spatialNavigationIndex != nullptr;
+}
+
 std::vector<View*>& Box::getChildren()
 {
     return this->children;
@@ -395,6 +470,11 @@ void Box::inflateFromXMLRes(std::string name)
 
 void Box::inflateFromXMLFile(std::string path)
 {
+    BXMLDocument* compiled = BXMLDocument::getCompiledFile(path);
+
+    if (compiled)
+        return Box::inflateFromBXML(compiled);
+
     // Load XML
     tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
     tinyxml2::XMLError error        = document->LoadFile(path.c_str());
@@ -431,6 +511,33 @@ void Box::handleXMLElement(tinyxml2::XMLElement* element)
     this->addView(View::createFromXMLElement(element));
 }
 
+void Box::inflateFromBXML(BXMLDocument* document)
+{
+    if (!document)
+        fatal("Invalid compiled XML when inflating " + this->describe());
+
+    return Box::inflateFromBXMLElement(document->getRootElement());
+}
+
+void Box::inflateFromBXMLElement(BXMLElement element)
+{
+    // Ensure element is a Box
+    if (element.getName() != "brls:Box")
+        fatal("First XML element is " + std::string(element.getName()) + ", expected brls:Box");
+
+    // Apply attributes
+    this->applyBXMLAttributes(element);
+
+    // Handle children
+    for (BXMLElement child = element.getFirstChild(); child.isValid(); child = child.getNextSibling())
+        this->addView(View::createFromBXMLElement(child)); // don't call handleBXMLElement because this method is for user XMLs
+}
+
+void Box::handleBXMLElement(BXMLElement element)
+{
+    this->addView(View::createFromBXMLElement(element));
+}
+
 void Box::setAxis(Axis axis)
 {
     YGNodeStyleSetFlexDirection(this->ygNode, getYGFlexDirection(axis));
@@ -516,31 +623,13 @@ void Box::setAlignItems(AlignItems alignment)
     this->invalidate();
 }
 
-View* Box::getView(std::string id)
-{
-    if (id == this->id)
-        return this;
-
-    for (View* child : this->children)
-    {
-        View* result = child->getView(id);
-
-        if (result)
-            return result;
-    }
-
-    return nullptr;
-}
-
-bool Box::applyXMLAttribute(std::string name, std::string value)
+bool Box::applyXMLAttributeValue(const std::string& name, const XMLValue& value)
 {
-    if (this->forwardedAttributes.count(name) > 0)
-    {
-        std::pair<std::string, View*> pair = this->forwardedAttributes[name];
-        return pair.second->applyXMLAttribute(pair.first, value);
-    }
+    auto forwarded = this->forwardedAttributes.find(name);
+    if (forwarded != this->forwardedAttributes.end())
+        return forwarded->second.second->applyXMLAttributeValue(forwarded->second.first, value);
 
-    return View::applyXMLAttribute(name, value);
+    return View::applyXMLAttributeValue(name, value);
 }
 
 void Box::forwardXMLAttribute(std::string attributeName, View* target)
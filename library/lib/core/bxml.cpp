@@ -0,0 +1,604 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <borealis/core/bxml.hpp>
+#include <charconv>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+#define BXML_MAGIC "BRLSBXML"
+#define BXML_VERSION 1
+#define BXML_NONE UINT32_MAX
+
+namespace brls
+{
+
+struct BXMLHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t stringsCount;
+    uint32_t elementsCount;
+    uint32_t attributesCount;
+};
+
+struct BXMLString
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct BXMLAttributeData
+{
+    uint32_t name;
+    uint32_t raw;
+    uint32_t type;
+    uint32_t payload;
+};
+
+static bool startsWith(std::string_view text, std::string_view prefix)
+{
+    return text.substr(0, prefix.size()) == prefix;
+}
+
+static bool endsWith(std::string_view text, std::string_view suffix)
+{
+    return text.size() >= suffix.size() && text.substr(text.size() - suffix.size()) == suffix;
+}
+
+// Same rules as std::stof(), without exceptions: leading spaces
+// and trailing characters are allowed
+static bool parseFloat(std::string_view text, float* value)
+{
+    // strtof() needs a null terminated string
+    std::string string(text);
+
+    const char* start = string.c_str();
+    char* end         = nullptr;
+
+    errno  = 0;
+    *value = strtof(start, &end);
+
+    return end != start && errno != ERANGE;
+}
+
+// "#RRGGBB" or "#RRGGBBAA"
+static bool parseColor(std::string_view text, NVGcolor* color)
+{
+    if (text.size() != 7 && text.size() != 9)
+        return false;
+
+    unsigned char channels[4] = { 0, 0, 0, 255 };
+
+    for (size_t i = 0; i < text.size() / 2; i++)
+    {
+        const char* first = text.data() + 1 + i * 2;
+
+        std::from_chars_result result = std::from_chars(first, first + 2, channels[i], 16);
+
+        if (result.ec != std::errc() || result.ptr != first + 2)
+            return false;
+    }
+
+    // Same as nvgRGBA()
+    color->r = channels[0] / 255.0f;
+    color->g = channels[1] / 255.0f;
+    color->b = channels[2] / 255.0f;
+    color->a = channels[3] / 255.0f;
+
+    return true;
+}
+
+static XMLValue referenceValue(XMLValueType type, std::string_view text, size_t prefixLength)
+{
+    XMLValue value;
+    value.type      = type;
+    value.raw       = text;
+    value.reference = text.substr(prefixLength);
+    return value;
+}
+
+XMLValue classifyXMLValue(std::string_view text)
+{
+    XMLValue value;
+    value.raw = text;
+
+    // The order matters: "@i18n/" and "@res/" values are never numbers, but
+    // "px" and "%" suffixes take precedence over the other prefixes
+    if (startsWith(text, "@i18n/"))
+        return referenceValue(XMLValueType::I18N, text, 6);
+    else if (startsWith(text, "@res/"))
+        return referenceValue(XMLValueType::RESOURCE, text, 5);
+    else if (text == "auto")
+        value.type = XMLValueType::AUTO;
+    else if (endsWith(text, "px"))
+        value.type = parseFloat(text.substr(0, text.size() - 2), &value.number) ? XMLValueType::FLOAT : XMLValueType::INVALID;
+    else if (endsWith(text, "%"))
+        value.type = parseFloat(text.substr(0, text.size() - 1), &value.number) ? XMLValueType::PERCENTAGE : XMLValueType::INVALID;
+    else if (startsWith(text, "@style/"))
+        return referenceValue(XMLValueType::STYLE, text, 7);
+    else if (startsWith(text, "#"))
+        value.type = parseColor(text, &value.color) ? XMLValueType::COLOR : XMLValueType::INVALID;
+    else if (startsWith(text, "@theme/"))
+        return referenceValue(XMLValueType::THEME, text, 7);
+    else if (text == "true" || text == "false")
+    {
+        value.type    = XMLValueType::BOOL;
+        value.boolean = text == "true";
+    }
+    else if (parseFloat(text, &value.number))
+        value.type = XMLValueType::FLOAT;
+
+    return value;
+}
+
+BXMLElement::BXMLElement(BXMLDocument* document, uint32_t index)
+    : document(document)
+    , index(index)
+{
+}
+
+bool BXMLElement::isValid()
+{
+    return this->document && this->index != BXML_NONE;
+}
+
+std::string_view BXMLElement::getName()
+{
+    return this->document->strings[this->getNameIndex()];
+}
+
+uint32_t BXMLElement::getNameIndex()
+{
+    return this->document->elements[this->index].name;
+}
+
+BXMLElement BXMLElement::getFirstChild()
+{
+    return BXMLElement(this->document, this->document->elements[this->index].firstChild);
+}
+
+BXMLElement BXMLElement::getNextSibling()
+{
+    return BXMLElement(this->document, this->document->elements[this->index].nextSibling);
+}
+
+const BXMLAttribute* BXMLElement::getAttributes()
+{
+    return this->document->attributes.data() + this->document->elements[this->index].firstAttribute;
+}
+
+size_t BXMLElement::getAttributesCount()
+{
+    return this->document->elements[this->index].attributesCount;
+}
+
+const BXMLAttribute* BXMLElement::findAttribute(std::string_view name)
+{
+    const BXMLAttribute* attributes = this->getAttributes();
+    size_t count                    = this->getAttributesCount();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (attributes[i].name == name)
+            return &attributes[i];
+    }
+
+    return nullptr;
+}
+
+BXMLDocument* BXMLElement::getDocument()
+{
+    return this->document;
+}
+
+// Builds the serialized form of a document from its XML
+class BXMLWriter
+{
+  public:
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringsIndex;
+
+    std::vector<uint32_t> elements; // 5 u32 per element
+    std::vector<BXMLAttributeData> attributes;
+
+    uint32_t addString(std::string string)
+    {
+        auto it = this->stringsIndex.find(string);
+
+        if (it != this->stringsIndex.end())
+            return it->second;
+
+        uint32_t index = this->strings.size();
+        this->strings.push_back(string);
+        this->stringsIndex[string] = index;
+        return index;
+    }
+
+    void addElement(tinyxml2::XMLElement* element)
+    {
+        uint32_t index = this->elements.size() / 5;
+
+        this->elements.insert(this->elements.end(), { this->addString(element->Name()), (uint32_t)this->attributes.size(), 0, BXML_NONE, BXML_NONE });
+
+        for (const tinyxml2::XMLAttribute* attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+        {
+            XMLValue value = classifyXMLValue(attribute->Value());
+
+            BXMLAttributeData data;
+            data.name    = this->addString(attribute->Name());
+            data.raw     = this->addString(attribute->Value());
+            data.type    = (uint32_t)value.type;
+            data.payload = 0;
+
+            switch (value.type)
+            {
+                case XMLValueType::I18N:
+                case XMLValueType::RESOURCE:
+                case XMLValueType::STYLE:
+                case XMLValueType::THEME:
+                    data.payload = value.raw.size() - value.reference.size(); // prefix length
+                    break;
+                case XMLValueType::FLOAT:
+                case XMLValueType::PERCENTAGE:
+                    memcpy(&data.payload, &value.number, sizeof(float));
+                    break;
+                case XMLValueType::COLOR:
+                    data.payload = (uint32_t)(value.color.r * 255.0f + 0.5f) | (uint32_t)(value.color.g * 255.0f + 0.5f) << 8 | (uint32_t)(value.color.b * 255.0f + 0.5f) << 16 | (uint32_t)(value.color.a * 255.0f + 0.5f) << 24;
+                    break;
+                case XMLValueType::BOOL:
+                    data.payload = value.boolean;
+                    break;
+                default:
+                    break;
+            }
+
+            this->attributes.push_back(data);
+            this->elements[index * 5 + 2]++;
+        }
+
+        // Children are written right after their parent
+        uint32_t previous = BXML_NONE;
+
+        for (tinyxml2::XMLElement* child = element->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+        {
+            uint32_t childIndex = this->elements.size() / 5;
+
+            if (previous == BXML_NONE)
+                this->elements[index * 5 + 3] = childIndex;
+            else
+                this->elements[previous * 5 + 4] = childIndex;
+
+            this->addElement(child);
+
+            previous = childIndex;
+        }
+    }
+
+    std::vector<char> write()
+    {
+        BXMLHeader header;
+        memcpy(header.magic, BXML_MAGIC, sizeof(header.magic));
+        header.version         = BXML_VERSION;
+        header.stringsCount    = this->strings.size();
+        header.elementsCount   = this->elements.size() / 5;
+        header.attributesCount = this->attributes.size();
+
+        std::vector<BXMLString> stringsTable;
+        std::string blob;
+
+        for (std::string& string : this->strings)
+        {
+            stringsTable.push_back(BXMLString { (uint32_t)blob.size(), (uint32_t)string.size() });
+            blob += string;
+        }
+
+        std::vector<char> data;
+        append(&data, &header, sizeof(header));
+        append(&data, stringsTable.data(), stringsTable.size() * sizeof(BXMLString));
+        append(&data, this->elements.data(), this->elements.size() * sizeof(uint32_t));
+        append(&data, this->attributes.data(), this->attributes.size() * sizeof(BXMLAttributeData));
+        append(&data, blob.data(), blob.size());
+        return data;
+    }
+
+  private:
+    static void append(std::vector<char>* data, const void* ptr, size_t size)
+    {
+        const char* bytes = (const char*)ptr;
+        data->insert(data->end(), bytes, bytes + size);
+    }
+};
+
+BXMLDocument* BXMLDocument::compile(tinyxml2::XMLElement* element, std::string* error)
+{
+    if (!element)
+    {
+        *error = "no root element found";
+        return nullptr;
+    }
+
+    BXMLWriter writer;
+    writer.addElement(element);
+
+    return BXMLDocument::load(writer.write(), error);
+}
+
+BXMLDocument* BXMLDocument::load(std::vector<char> data, std::string* error)
+{
+    BXMLHeader header;
+
+    if (data.size() < sizeof(header))
+    {
+        *error = "file too small";
+        return nullptr;
+    }
+
+    memcpy(&header, data.data(), sizeof(header));
+
+    if (memcmp(header.magic, BXML_MAGIC, sizeof(header.magic)) != 0)
+    {
+        *error = "invalid magic";
+        return nullptr;
+    }
+
+    if (header.version != BXML_VERSION)
+    {
+        *error = "unsupported version " + std::to_string(header.version);
+        return nullptr;
+    }
+
+    if (header.elementsCount == 0)
+    {
+        *error = "no root element found";
+        return nullptr;
+    }
+
+    size_t stringsOffset    = sizeof(header);
+    size_t elementsOffset   = stringsOffset + (size_t)header.stringsCount * sizeof(BXMLString);
+    size_t attributesOffset = elementsOffset + (size_t)header.elementsCount * sizeof(Element);
+    size_t blobOffset       = attributesOffset + (size_t)header.attributesCount * sizeof(BXMLAttributeData);
+
+    if (blobOffset > data.size())
+    {
+        *error = "truncated file";
+        return nullptr;
+    }
+
+    BXMLDocument* document = new BXMLDocument();
+    document->data         = std::move(data);
+
+    const char* bytes = document->data.data();
+    size_t blobSize   = document->data.size() - blobOffset;
+
+    // Strings
+    document->strings.reserve(header.stringsCount);
+
+    for (uint32_t i = 0; i < header.stringsCount; i++)
+    {
+        BXMLString string;
+        memcpy(&string, bytes + stringsOffset + i * sizeof(BXMLString), sizeof(string));
+
+        if ((size_t)string.offset + string.length > blobSize)
+        {
+            *error = "string out of bounds";
+            delete document;
+            return nullptr;
+        }
+
+        document->strings.push_back(std::string_view(bytes + blobOffset + string.offset, string.length));
+    }
+
+    // Elements
+    document->elements.resize(header.elementsCount);
+    memcpy(document->elements.data(), bytes + elementsOffset, header.elementsCount * sizeof(Element));
+
+    for (uint32_t i = 0; i < header.elementsCount; i++)
+    {
+        Element& element = document->elements[i];
+
+        bool valid = element.name < header.stringsCount
+            && (size_t)element.firstAttribute + element.attributesCount <= header.attributesCount
+            && (element.firstChild == BXML_NONE || element.firstChild < header.elementsCount)
+            && (element.nextSibling == BXML_NONE || element.nextSibling < header.elementsCount);
+
+        if (!valid)
+        {
+            *error = "element out of bounds";
+            delete document;
+            return nullptr;
+        }
+
+        // Elements are stored depth first: children and siblings always come after,
+        // which also guarantees that walking the tree ends
+        if ((element.firstChild != BXML_NONE && element.firstChild <= i) || (element.nextSibling != BXML_NONE && element.nextSibling <= i))
+        {
+            *error = "element " + std::to_string(i) + " is not in depth first order";
+            delete document;
+            return nullptr;
+        }
+    }
+
+    // Attributes, decoded once so that applying them is only a copy
+    document->attributes.reserve(header.attributesCount);
+
+    for (uint32_t i = 0; i < header.attributesCount; i++)
+    {
+        BXMLAttributeData data;
+        memcpy(&data, bytes + attributesOffset + i * sizeof(BXMLAttributeData), sizeof(data));
+
+        if (data.name >= header.stringsCount || data.raw >= header.stringsCount || data.type > (uint32_t)XMLValueType::INVALID)
+        {
+            *error = "attribute out of bounds";
+            delete document;
+            return nullptr;
+        }
+
+        BXMLAttribute attribute;
+        attribute.name       = std::string(document->strings[data.name]);
+        attribute.value.type = (XMLValueType)data.type;
+        attribute.value.raw  = document->strings[data.raw];
+
+        switch (attribute.value.type)
+        {
+            case XMLValueType::I18N:
+            case XMLValueType::RESOURCE:
+            case XMLValueType::STYLE:
+            case XMLValueType::THEME:
+                if (data.payload > attribute.value.raw.size())
+                {
+                    *error = "attribute out of bounds";
+                    delete document;
+                    return nullptr;
+                }
+
+                attribute.value.reference = attribute.value.raw.substr(data.payload);
+                break;
+            case XMLValueType::FLOAT:
+            case XMLValueType::PERCENTAGE:
+                memcpy(&attribute.value.number, &data.payload, sizeof(float));
+                break;
+            case XMLValueType::COLOR:
+                attribute.value.color.r = (data.payload & 0xFF) / 255.0f;
+                attribute.value.color.g = ((data.payload >> 8) & 0xFF) / 255.0f;
+                attribute.value.color.b = ((data.payload >> 16) & 0xFF) / 255.0f;
+                attribute.value.color.a = ((data.payload >> 24) & 0xFF) / 255.0f;
+                break;
+            case XMLValueType::BOOL:
+                attribute.value.boolean = data.payload != 0;
+                break;
+            default:
+                break;
+        }
+
+        document->attributes.push_back(attribute);
+    }
+
+    document->viewCreators.resize(header.stringsCount);
+
+    return document;
+}
+
+BXMLDocument* BXMLDocument::loadFile(std::string path, std::string* error)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (!file)
+    {
+        *error = "cannot open file";
+        return nullptr;
+    }
+
+    std::vector<char> data;
+    char buffer[4096];
+    size_t read;
+
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + read);
+
+    fclose(file);
+
+    return BXMLDocument::load(std::move(data), error);
+}
+
+std::vector<char> BXMLDocument::serialize()
+{
+    return this->data;
+}
+
+BXMLElement BXMLDocument::getRootElement()
+{
+    return BXMLElement(this, 0);
+}
+
+std::vector<std::function<View*(void)>>& BXMLDocument::getViewCreators()
+{
+    return this->viewCreators;
+}
+
+std::string BXMLDocument::getCompiledPath(std::string xmlPath)
+{
+    if (endsWith(xmlPath, ".xml"))
+        return xmlPath.substr(0, xmlPath.size() - 4) + ".bxml";
+
+    return xmlPath + ".bxml";
+}
+
+static std::mutex cacheMutex;
+static std::unordered_map<std::string, BXMLDocument*> compiledFiles;
+static std::unordered_map<std::string, BXMLDocument*> compiledStrings;
+
+BXMLDocument* BXMLDocument::getCompiledFile(std::string xmlPath)
+{
+    std::unique_lock<std::mutex> lock(cacheMutex);
+
+    auto it = compiledFiles.find(xmlPath);
+    if (it != compiledFiles.end())
+        return it->second;
+
+    std::string compiledPath = BXMLDocument::getCompiledPath(xmlPath);
+    std::error_code code;
+
+    std::filesystem::file_time_type compiledTime = std::filesystem::last_write_time(compiledPath, code);
+    if (code)
+        return nullptr;
+
+    // Don't use stale compiled files while editing the XML
+    std::filesystem::file_time_type xmlTime = std::filesystem::last_write_time(xmlPath, code);
+    if (!code && xmlTime > compiledTime)
+        return nullptr;
+
+    std::string error;
+    BXMLDocument* document = BXMLDocument::loadFile(compiledPath, &error);
+
+    // Fallback to the XML file, which will report its own errors
+    if (!document)
+        return nullptr;
+
+    compiledFiles[xmlPath] = document;
+    return document;
+}
+
+BXMLDocument* BXMLDocument::getCompiledString(const std::string& xml)
+{
+    std::unique_lock<std::mutex> lock(cacheMutex);
+
+    auto it = compiledStrings.find(xml);
+    if (it != compiledStrings.end())
+        return it->second;
+
+    tinyxml2::XMLDocument xmlDocument;
+    if (xmlDocument.Parse(xml.c_str()) != tinyxml2::XMLError::XML_SUCCESS)
+        return nullptr;
+
+    std::string error;
+    BXMLDocument* document = BXMLDocument::compile(xmlDocument.RootElement(), &error);
+
+    if (!document)
+        return nullptr;
+
+    compiledStrings[xml] = document;
+    return document;
+}
+
+} // namespace brls
@@ -19,9 +19,25 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/assets.hpp>
 #include <borealis/core/font.hpp>
+#include <borealis/core/i18n.hpp>
+#include <borealis/core/time.hpp>
+#include <cstring>
+#include <fstream>
 
 #define MATERIAL_ICONS_PATH BRLS_ASSET("material/MaterialIcons-Regular.ttf")
 
+#define GLYPH_CACHE_MAGIC "BRLSGLYC"
+#define GLYPH_CACHE_VERSION 2
+
+// Amount of font data hashed to detect changed fonts, in bytes
+#define GLYPH_CACHE_FINGERPRINT_SIZE 65536
+
+// Time spent rasterizing glyphs every frame, in us
+#define GLYPH_PREWARM_FRAME_BUDGET 2000
+
+// Amount of characters rasterized in one go
+#define GLYPH_PREWARM_CHUNK_SIZE 8
+
 namespace brls
 {
 
@@ -49,4 +65,284 @@ bool FontLoader::loadMaterialFromResources()
     return this->loadFontFromFile(FONT_MATERIAL_ICONS, MATERIAL_ICONS_PATH);
 }
 
+void FontLoader::setGlyphCachePath(std::string path)
+{
+    FontLoader::glyphCachePath = path;
+}
+
+std::string FontLoader::getGlyphCachePath()
+{
+    return FontLoader::glyphCachePath;
+}
+
+// FNV-1a of the beginning of the font data, mixed with its size
+static uint64_t getFontFingerprint(NVGcontext* vg, int font, uint32_t* dataSize)
+{
+    int size                  = 0;
+    const unsigned char* data = nvgFontData(vg, font, &size);
+    uint64_t hash             = 14695981039346656037ULL;
+
+    *dataSize = (uint32_t)size;
+
+    if (!data)
+        return 0;
+
+    for (int i = 0; i < size && i < GLYPH_CACHE_FINGERPRINT_SIZE; i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash ^ (uint64_t)size;
+}
+
+template <typename T>
+static void writeValue(std::ofstream& stream, T value)
+{
+    stream.write((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static bool readValue(std::ifstream& stream, T* value)
+{
+    return (bool)stream.read((char*)value, sizeof(T));
+}
+
+bool FontLoader::loadGlyphCache()
+{
+    if (FontLoader::glyphCachePath.empty())
+        return false;
+
+    std::ifstream stream(FontLoader::glyphCachePath, std::ios::binary);
+
+    if (!stream.is_open())
+    {
+        BRLS_LOG_DEBUG("No glyph cache found at \"{}\"", FontLoader::glyphCachePath);
+        return false;
+    }
+
+    char magic[sizeof(GLYPH_CACHE_MAGIC) - 1];
+    uint32_t version, sdf, fontsCount;
+
+    if (!stream.read(magic, sizeof(magic)) || memcmp(magic, GLYPH_CACHE_MAGIC, sizeof(magic)) != 0
+        || !readValue(stream, &version) || version != GLYPH_CACHE_VERSION
+        || !readValue(stream, &sdf) || !readValue(stream, &fontsCount))
+    {
+        Logger::warning("Ignoring invalid or outdated glyph cache \"{}\"", FontLoader::glyphCachePath);
+        return false;
+    }
+
+    NVGcontext* vg = Application::getNVGContext();
+
+    // Bitmap and distance field glyphs cannot be mixed
+    if (sdf != (uint32_t)nvgTextIsSDF(vg))
+    {
+        Logger::info("Ignoring glyph cache \"{}\": text rendering mode changed", FontLoader::glyphCachePath);
+        return false;
+    }
+    std::vector<unsigned char> bitmap;
+    size_t imported = 0;
+    bool atlasFull  = false;
+
+    for (uint32_t i = 0; i < fontsCount; i++)
+    {
+        uint32_t nameLength, dataSize, glyphsCount;
+        uint64_t fingerprint;
+
+        if (!readValue(stream, &nameLength))
+            return false;
+
+        std::string name(nameLength, '\0');
+
+        if (!stream.read(&name[0], nameLength) || !readValue(stream, &dataSize)
+            || !readValue(stream, &fingerprint) || !readValue(stream, &glyphsCount))
+            return false;
+
+        // Only import the glyphs if the font is the same as when the cache was written
+        int font = Application::getFont(name);
+        bool valid = false;
+
+        if (font != FONT_INVALID)
+        {
+            uint32_t currentDataSize;
+            uint64_t currentFingerprint = getFontFingerprint(vg, font, &currentDataSize);
+            valid                       = currentDataSize == dataSize && currentFingerprint == fingerprint;
+        }
+
+        if (!valid)
+            BRLS_LOG_DEBUG("Ignoring cached glyphs of font \"{}\"", name);
+
+        for (uint32_t j = 0; j < glyphsCount; j++)
+        {
+            NVGcachedGlyph glyph;
+
+            if (!readValue(stream, &glyph) || glyph.width < 0 || glyph.height < 0)
+                return false;
+
+            bitmap.resize((size_t)glyph.width * glyph.height);
+
+            if (!stream.read((char*)bitmap.data(), bitmap.size()))
+                return false;
+
+            if (!valid || atlasFull)
+                continue;
+
+            if (nvgImportFontGlyph(vg, font, &glyph, bitmap.data()))
+                imported++;
+            else
+                atlasFull = true;
+        }
+    }
+
+    if (atlasFull)
+        Logger::warning("Font atlas is full, some cached glyphs were not loaded");
+
+    Logger::info("Loaded {} glyphs from glyph cache", imported);
+    return true;
+}
+
+bool FontLoader::saveGlyphCache()
+{
+    if (FontLoader::glyphCachePath.empty())
+        return false;
+
+    std::ofstream stream(FontLoader::glyphCachePath, std::ios::binary | std::ios::trunc);
+
+    if (!stream.is_open())
+    {
+        Logger::error("Cannot write glyph cache to \"{}\"", FontLoader::glyphCachePath);
+        return false;
+    }
+
+    NVGcontext* vg       = Application::getNVGContext();
+    FontStash* fontStash = Application::getFontStash();
+
+    stream.write(GLYPH_CACHE_MAGIC, sizeof(GLYPH_CACHE_MAGIC) - 1);
+    writeValue<uint32_t>(stream, GLYPH_CACHE_VERSION);
+    writeValue<uint32_t>(stream, nvgTextIsSDF(vg));
+    writeValue<uint32_t>(stream, fontStash->size());
+
+    std::vector<unsigned char> bitmap;
+    size_t saved = 0;
+
+    for (auto& font : *fontStash)
+    {
+        uint32_t dataSize;
+        uint64_t fingerprint = getFontFingerprint(vg, font.second, &dataSize);
+
+        // Only keep rasterized glyphs
+        std::vector<int> glyphs;
+        int count = nvgFontGlyphCount(vg, font.second);
+
+        for (int i = 0; i < count; i++)
+        {
+            NVGcachedGlyph glyph;
+            if (nvgExportFontGlyph(vg, font.second, i, &glyph, nullptr, 0))
+                glyphs.push_back(i);
+        }
+
+        writeValue<uint32_t>(stream, font.first.size());
+        stream.write(font.first.data(), font.first.size());
+        writeValue<uint32_t>(stream, dataSize);
+        writeValue<uint64_t>(stream, fingerprint);
+        writeValue<uint32_t>(stream, glyphs.size());
+
+        for (int i : glyphs)
+        {
+            NVGcachedGlyph glyph;
+            nvgExportFontGlyph(vg, font.second, i, &glyph, nullptr, 0);
+
+            bitmap.resize((size_t)glyph.width * glyph.height);
+            nvgExportFontGlyph(vg, font.second, i, &glyph, bitmap.data(), bitmap.size());
+
+            writeValue(stream, glyph);
+            stream.write((const char*)bitmap.data(), bitmap.size());
+        }
+
+        saved += glyphs.size();
+    }
+
+    if (!stream.good())
+    {
+        Logger::error("Error while writing glyph cache to \"{}\"", FontLoader::glyphCachePath);
+        return false;
+    }
+
+    Logger::info("Saved {} glyphs to glyph cache", saved);
+    return true;
+}
+
+void GlyphPrewarmer::prewarm(std::string fontName, std::vector<float> sizes, std::string characters)
+{
+    int font = Application::getFont(fontName);
+
+    if (font == FONT_INVALID)
+    {
+        Logger::warning("Cannot prewarm glyphs of font \"{}\": font is not loaded", fontName);
+        return;
+    }
+
+    for (float size : sizes)
+    {
+        Job job;
+        job.font       = font;
+        job.size       = size;
+        job.characters = characters;
+
+        GlyphPrewarmer::jobs.push_back(job);
+    }
+}
+
+void GlyphPrewarmer::prewarmTranslations(std::vector<float> sizes, std::string fontName)
+{
+    GlyphPrewarmer::prewarm(fontName, sizes, getTranslationsCharacters());
+}
+
+bool GlyphPrewarmer::isDone()
+{
+    return GlyphPrewarmer::jobs.empty();
+}
+
+void GlyphPrewarmer::frame()
+{
+    if (GlyphPrewarmer::jobs.empty())
+        return;
+
+    NVGcontext* vg = Application::getNVGContext();
+    Time start     = getCPUTimeUsec();
+
+    nvgSave(vg);
+
+    while (!GlyphPrewarmer::jobs.empty() && getCPUTimeUsec() - start < GLYPH_PREWARM_FRAME_BUDGET)
+    {
+        Job& job = GlyphPrewarmer::jobs.front();
+
+        // Take the next chunk of characters without splitting UTF-8 sequences
+        size_t end = job.offset;
+        for (int i = 0; i < GLYPH_PREWARM_CHUNK_SIZE && end < job.characters.size(); i++)
+        {
+            end++;
+            while (end < job.characters.size() && (job.characters[end] & 0xC0) == 0x80)
+                end++;
+        }
+
+        nvgFontFaceId(vg, job.font);
+        nvgFontSize(vg, job.size);
+
+        if (!nvgTextPrewarm(vg, job.characters.c_str() + job.offset, job.characters.c_str() + end))
+        {
+            Logger::warning("Font atlas is full, stopping glyphs prewarming");
+            GlyphPrewarmer::jobs.clear();
+            break;
+        }
+
+        job.offset = end;
+
+        if (job.offset >= job.characters.size())
+            GlyphPrewarmer::jobs.pop_front();
+    }
+
+    nvgRestore(vg);
+}
+
 } // namespace brls
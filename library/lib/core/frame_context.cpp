@@ -0,0 +1,40 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/frame_context.hpp>
+
+namespace brls
+{
+
+void FrameContext::pushScissor(float x, float y, float width, float height)
+{
+    NVGscissor scissor;
+    nvgCurrentScissor(this->vg, &scissor);
+    this->scissors.push_back(scissor);
+
+    nvgIntersectScissor(this->vg, x, y, width, height);
+}
+
+void FrameContext::popScissor()
+{
+    if (this->scissors.empty())
+        return;
+
+    nvgRestoreScissor(this->vg, &this->scissors.back());
+    this->scissors.pop_back();
+}
+
+} // namespace brls
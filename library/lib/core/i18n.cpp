@@ -17,16 +17,56 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/assets.hpp>
 #include <borealis/core/i18n.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+
+#if !defined(__SWITCH__) && !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define I18N_BUNDLE_MMAP
+#endif
+
+// Binary bundles compiled by scripts/i18n-bundler.py, see the script for the format
+#define I18N_BUNDLE_MAGIC "BRLSI18N"
+#define I18N_BUNDLE_VERSION 1
 
 namespace brls
 {
 
-static nlohmann::json defaultLocale = {};
-static nlohmann::json currentLocale = {};
+// Every string of the loaded locales, keyed by their full name ("file/key/subkey")
+// Keys and values point into the loaded bundle, or into stringsStorage when
+// loaded from the JSON files. Both are only written when loading
+static std::string stringsStorage;
+static std::unordered_map<std::string_view, std::string_view> strings;
+
+static char* bundleData  = nullptr;
+static size_t bundleSize  = 0;
+static bool bundleMapped = false;
+
+struct BundleHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+};
+
+struct BundleEntry
+{
+    uint32_t hash;
+    uint32_t keyOffset, keyLength;
+    uint32_t valueOffset, valueLength;
+};
 
 static bool endsWith(const std::string& str, const std::string& suffix)
 {
@@ -34,7 +74,25 @@ static bool endsWith(const std::string& str, const std::string& suffix)
     return str.size() >= suffix.size() && 0 == str.compare(str.size() - suffix.size(), suffix.size(), suffix);
 }
 
-static void loadLocale(std::string locale, nlohmann::json* target)
+static void flattenStrings(const nlohmann::json& json, const std::string& name, std::unordered_map<std::string, std::string>* target)
+{
+    if (json.is_string())
+    {
+        (*target)[name] = json.get<std::string>();
+    }
+    else if (json.is_object())
+    {
+        for (auto& item : json.items())
+            flattenStrings(item.value(), name + "/" + item.key(), target);
+    }
+    else if (json.is_array())
+    {
+        for (size_t i = 0; i < json.size(); i++)
+            flattenStrings(json[i], name + "/" + std::to_string(i), target);
+    }
+}
+
+static void loadLocale(std::string locale, std::unordered_map<std::string, std::string>* target)
 {
     std::string localePath = BRLS_ASSET("i18n/" + locale);
 
@@ -62,14 +120,14 @@ static void loadLocale(std::string locale, nlohmann::json* target)
 
         std::string path = entry.path().string();
 
-        nlohmann::json strings;
+        nlohmann::json json;
 
         std::ifstream jsonStream;
         jsonStream.open(path);
 
         try
         {
-            jsonStream >> strings;
+            jsonStream >> json;
         }
         catch (const std::exception& e)
         {
@@ -78,55 +136,258 @@ static void loadLocale(std::string locale, nlohmann::json* target)
 
         jsonStream.close();
 
-        (*target)[name.substr(0, name.length() - 5)] = strings;
+        flattenStrings(json, name.substr(0, name.length() - 5), target);
     }
 }
 
-void loadTranslations()
+static void unloadBundle()
 {
-    loadLocale(LOCALE_DEFAULT, &defaultLocale);
+    if (!bundleData)
+        return;
 
-    std::string currentLocaleName = Application::getLocale();
-    if (currentLocaleName != LOCALE_DEFAULT)
-        loadLocale(currentLocaleName, &currentLocale);
+#ifdef I18N_BUNDLE_MMAP
+    if (bundleMapped)
+        munmap(bundleData, bundleSize);
+    else
+        free(bundleData);
+#else
+    free(bundleData);
+#endif
+
+    bundleData   = nullptr;
+    bundleSize   = 0;
+    bundleMapped = false;
 }
 
-namespace internal
+static bool readBundle(const std::string& path)
 {
-    std::string getRawStr(std::string stringName)
+#ifdef I18N_BUNDLE_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
     {
-        nlohmann::json::json_pointer pointer;
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
 
-        try
+        if (data != MAP_FAILED)
         {
-            pointer = nlohmann::json::json_pointer("/" + stringName);
-        }
-        catch (const std::exception& e)
-        {
-            Logger::error("Error while getting string \"{}\": {}", stringName, e.what());
-            return stringName;
+            bundleData   = (char*)data;
+            bundleSize   = st.st_size;
+            bundleMapped = true;
         }
+    }
 
-        // First look for translated string in current locale
-        try
+    close(fd);
+#else
+    // One read for the whole bundle (romfs)
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size > 0)
+    {
+        bundleData = (char*)malloc(size);
+
+        if (bundleData && fread(bundleData, 1, size, file) == (size_t)size)
         {
-            return currentLocale[pointer].get<std::string>();
+            bundleSize = size;
         }
-        catch (...)
+        else
         {
+            free(bundleData);
+            bundleData = nullptr;
         }
+    }
 
-        // Then look for default locale
-        try
+    fclose(file);
+#endif
+
+    if (!bundleData)
+        Logger::error("Cannot read locale bundle {}", path);
+
+    return bundleData != nullptr;
+}
+
+// Returns true if a JSON file of the given locale was edited after the bundle was compiled
+static bool isBundleStale(std::filesystem::file_time_type bundleTime, std::string locale)
+{
+    std::error_code code;
+    std::filesystem::directory_iterator iterator(BRLS_ASSET("i18n/" + locale), code);
+
+    if (code)
+        return false;
+
+    for (const std::filesystem::directory_entry& entry : iterator)
+    {
+        if (!endsWith(entry.path().filename().string(), ".json"))
+            continue;
+
+        std::filesystem::file_time_type jsonTime = std::filesystem::last_write_time(entry.path(), code);
+        if (!code && jsonTime > bundleTime)
+            return true;
+    }
+
+    return false;
+}
+
+static bool loadBundle(std::string locale)
+{
+    std::string path = BRLS_ASSET("i18n_bundles/" + locale + ".bin");
+    std::error_code code;
+
+    std::filesystem::file_time_type bundleTime = std::filesystem::last_write_time(path, code);
+    if (code)
+        return false;
+
+    // Don't use stale bundles while editing the translations
+    if (isBundleStale(bundleTime, LOCALE_DEFAULT) || (locale != LOCALE_DEFAULT && isBundleStale(bundleTime, locale)))
+    {
+        Logger::warning("Locale bundle {} is older than the JSON files, loading the JSON files instead", path);
+        return false;
+    }
+
+    if (!readBundle(path))
+        return false;
+
+    BundleHeader header;
+    if (bundleSize < sizeof(header))
+    {
+        Logger::error("Cannot load locale bundle {}: file is truncated", path);
+        unloadBundle();
+        return false;
+    }
+
+    memcpy(&header, bundleData, sizeof(header));
+
+    if (memcmp(header.magic, I18N_BUNDLE_MAGIC, sizeof(header.magic)) != 0 || header.version != I18N_BUNDLE_VERSION)
+    {
+        Logger::error("Cannot load locale bundle {}: unknown format, please rebuild it", path);
+        unloadBundle();
+        return false;
+    }
+
+    size_t indexSize = (size_t)header.count * sizeof(BundleEntry);
+    if (bundleSize - sizeof(header) < indexSize)
+    {
+        Logger::error("Cannot load locale bundle {}: file is truncated", path);
+        unloadBundle();
+        return false;
+    }
+
+    const char* index = bundleData + sizeof(header);
+    const char* blob  = index + indexSize;
+    size_t blobSize   = bundleSize - sizeof(header) - indexSize;
+
+    strings.reserve(header.count);
+
+    for (uint32_t i = 0; i < header.count; i++)
+    {
+        BundleEntry entry;
+        memcpy(&entry, index + i * sizeof(entry), sizeof(entry));
+
+        if ((size_t)entry.keyOffset + entry.keyLength > blobSize || (size_t)entry.valueOffset + entry.valueLength > blobSize)
         {
-            return defaultLocale[pointer].get<std::string>();
+            Logger::error("Cannot load locale bundle {}: string {} is out of bounds", path, i);
+            strings.clear();
+            unloadBundle();
+            return false;
         }
-        catch (...)
+
+        std::string_view key(blob + entry.keyOffset, entry.keyLength);
+        strings[key] = std::string_view(blob + entry.valueOffset, entry.valueLength);
+    }
+
+    BRLS_LOG_DEBUG("Loaded {} strings from locale bundle {}", header.count, path);
+    return true;
+}
+
+void loadTranslations()
+{
+    loadTranslations(Application::getLocale());
+}
+
+void loadTranslations(std::string currentLocaleName)
+{
+    strings.clear();
+    stringsStorage.clear();
+    unloadBundle();
+
+    // Bundles already contain the default locale strings, so one is enough
+    if (loadBundle(currentLocaleName))
+        return;
+
+    // Development fallback: JSON files, the current locale overrides the default one
+    std::unordered_map<std::string, std::string> loaded;
+
+    loadLocale(LOCALE_DEFAULT, &loaded);
+
+    if (currentLocaleName != LOCALE_DEFAULT)
+        loadLocale(currentLocaleName, &loaded);
+
+    // Intern everything in one buffer, reserved upfront so that the views stay valid
+    size_t size = 0;
+    for (auto& entry : loaded)
+        size += entry.first.size() + entry.second.size();
+
+    strings.reserve(loaded.size());
+    stringsStorage.reserve(size);
+
+    for (auto& entry : loaded)
+    {
+        size_t offset = stringsStorage.size();
+        stringsStorage += entry.first;
+        stringsStorage += entry.second;
+
+        std::string_view key(stringsStorage.data() + offset, entry.first.size());
+        std::string_view value(stringsStorage.data() + offset + entry.first.size(), entry.second.size());
+        strings[key] = value;
+    }
+}
+
+std::string getTranslationsCharacters()
+{
+    std::set<std::string_view> characters;
+
+    for (auto& entry : strings)
+    {
+        std::string_view str = entry.second;
+
+        // Split on UTF-8 sequence boundaries
+        for (size_t i = 0; i < str.size();)
         {
+            size_t length = 1;
+            while (i + length < str.size() && (str[i + length] & 0xC0) == 0x80)
+                length++;
+
+            characters.insert(str.substr(i, length));
+            i += length;
         }
+    }
+
+    std::string result;
+    for (std::string_view character : characters)
+        result += character;
+
+    return result;
+}
+
+namespace internal
+{
+    std::string_view getRawStr(std::string_view stringName)
+    {
+        auto it = strings.find(stringName);
 
         // Fallback to returning the string name
-        return stringName;
+        if (it == strings.end())
+            return stringName;
+
+        return it->second;
     }
 } // namespace internal
 
@@ -134,7 +395,7 @@ inline namespace literals
 {
     std::string operator"" _i18n(const char* str, size_t len)
     {
-        return internal::getRawStr(std::string(str, len));
+        return std::string(internal::getRawStr(std::string_view(str, len)));
     }
 
 } // namespace literals
@@ -0,0 +1,124 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/log_sink.hpp>
+
+namespace brls
+{
+
+const char* getLogLevelName(LogLevel level)
+{
+    switch (level)
+    {
+        case LogLevel::ERROR:
+            return "ERROR";
+        case LogLevel::WARNING:
+            return "WARNING";
+        case LogLevel::INFO:
+            return "INFO";
+        case LogLevel::DEBUG:
+        default:
+            return "DEBUG";
+    }
+}
+
+static const char* getLogLevelColor(LogLevel level)
+{
+    switch (level)
+    {
+        case LogLevel::ERROR:
+            return "[0;31m";
+        case LogLevel::WARNING:
+            return "[0;33m";
+        case LogLevel::INFO:
+            return "[0;34m";
+        case LogLevel::DEBUG:
+        default:
+            return "[0;32m";
+    }
+}
+
+void ConsoleLogSink::write(LogLevel level, Time, std::string_view message)
+{
+    printf("\033%s[%s]\033[0m %.*s\n", getLogLevelColor(level), getLogLevelName(level), (int)message.size(), message.data());
+}
+
+void ConsoleLogSink::flush()
+{
+    fflush(stdout);
+}
+
+FileLogSink::FileLogSink(std::string path)
+{
+    this->file = fopen(path.c_str(), "a");
+}
+
+FileLogSink::~FileLogSink()
+{
+    if (this->file)
+        fclose(this->file);
+}
+
+bool FileLogSink::isOpen()
+{
+    return this->file != nullptr;
+}
+
+void FileLogSink::write(LogLevel level, Time time, std::string_view message)
+{
+    if (!this->file)
+        return;
+
+    fprintf(this->file, "[%lld.%06lld] [%s] %.*s\n", (long long)(time / 1000000), (long long)(time % 1000000), getLogLevelName(level), (int)message.size(), message.data());
+}
+
+void FileLogSink::flush()
+{
+    if (this->file)
+        fflush(this->file);
+}
+
+MemoryLogSink::MemoryLogSink(size_t maxLines)
+    : maxLines(maxLines)
+{
+}
+
+std::vector<std::string> MemoryLogSink::getLines()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return std::vector<std::string>(this->lines.begin(), this->lines.end());
+}
+
+void MemoryLogSink::clear()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->lines.clear();
+}
+
+void MemoryLogSink::write(LogLevel level, Time, std::string_view message)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    if (this->maxLines == 0)
+        return;
+
+    while (this->lines.size() >= this->maxLines)
+        this->lines.pop_front();
+
+    this->lines.push_back(std::string("[") + getLogLevelName(level) + "] " + std::string(message));
+}
+
+} // namespace brls
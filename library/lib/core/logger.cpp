@@ -15,17 +15,308 @@
     limitations under the License.
 */
 
-#include <fmt/core.h>
 #include <stdio.h>
+#include <string.h>
 
+#include <algorithm>
+#include <atomic>
 #include <borealis/core/logger.hpp>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Number of messages the ring buffer can hold, must be a power of two
+#define LOG_RING_SIZE 512
+
+// Longer messages are truncated
+#define LOG_MESSAGE_MAX_LENGTH 256
+
+// How long the logger thread sleeps when there is nothing to write, in ms
+#define LOG_DRAIN_PERIOD 5
 
 namespace brls
 {
 
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE must be a power of two");
+
+// Bounded multiple producers, single consumer queue (Vyukov): every slot has a sequence
+// number telling whether it's free for the enqueue position or filled for the dequeue one.
+// Producers claim a slot with a CAS on the enqueue position, the consumer is the only
+// one moving the dequeue position (it holds drainMutex).
+struct LogSlot
+{
+    std::atomic<size_t> sequence;
+
+    LogLevel level;
+    Time time;
+    size_t length;
+    char message[LOG_MESSAGE_MAX_LENGTH];
+};
+
+struct LogRing
+{
+    LogSlot slots[LOG_RING_SIZE];
+
+    std::atomic<size_t> enqueuePosition = 0;
+    size_t dequeuePosition              = 0;
+
+    std::atomic<size_t> droppedMessages = 0;
+
+    LogRing()
+    {
+        for (size_t i = 0; i < LOG_RING_SIZE; i++)
+            this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bool push(LogLevel level, const char* message, size_t length)
+    {
+        size_t position = this->enqueuePosition.load(std::memory_order_relaxed);
+        LogSlot* slot;
+
+        while (true)
+        {
+            slot              = &this->slots[position & (LOG_RING_SIZE - 1)];
+            size_t sequence   = slot->sequence.load(std::memory_order_acquire);
+            intptr_t distance = (intptr_t)sequence - (intptr_t)position;
+
+            if (distance == 0)
+            {
+                if (this->enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (distance < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                position = this->enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level  = level;
+        slot->time   = getCPUTimeUsec();
+        slot->length = std::min(length, (size_t)LOG_MESSAGE_MAX_LENGTH);
+        memcpy(slot->message, message, slot->length);
+
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Must be called with drainMutex held
+    LogSlot* front()
+    {
+        LogSlot* slot = &this->slots[this->dequeuePosition & (LOG_RING_SIZE - 1)];
+
+        if (slot->sequence.load(std::memory_order_acquire) != this->dequeuePosition + 1)
+            return nullptr; // empty
+
+        return slot;
+    }
+
+    // Must be called with drainMutex held, after front()
+    void pop(LogSlot* slot)
+    {
+        slot->sequence.store(this->dequeuePosition + LOG_RING_SIZE, std::memory_order_release);
+        this->dequeuePosition++;
+    }
+};
+
+static LogRing& getRing()
+{
+    static LogRing ring;
+    return ring;
+}
+
+static ConsoleLogSink* getDefaultConsoleSink()
+{
+    static ConsoleLogSink consoleSink;
+    return &consoleSink;
+}
+
+static std::vector<LogSink*>& getSinks()
+{
+    static std::vector<LogSink*> sinks = { getDefaultConsoleSink() };
+    return sinks;
+}
+
+// Held by whoever writes to the sinks
+static std::mutex drainMutex;
+
+static std::atomic<bool> asynchronous = false;
+static std::atomic<bool> stopping     = false;
+
+static bool drain();
+
+// Owns the logger thread. If the app leaves without going through Application::exit()
+// (exit(), returning from main after a fatal error...), the thread is stopped and joined
+// when static objects are destroyed, instead of std::terminate() being called, and the
+// queued messages are still written.
+struct LoggerThread
+{
+    std::thread thread;
+
+    LoggerThread()
+    {
+        // Constructed before, so destroyed after the thread is stopped
+        getRing();
+        getSinks();
+    }
+
+    ~LoggerThread()
+    {
+        if (!this->thread.joinable())
+            return;
+
+        stopping = true;
+        this->thread.join();
+        asynchronous = false;
+
+        std::unique_lock<std::mutex> lock(drainMutex);
+        drain();
+    }
+};
+
+static std::thread& getThread()
+{
+    static LoggerThread loggerThread;
+    return loggerThread.thread;
+}
+
+// Writes the queued messages to the sinks, drainMutex must be held
+static bool drain()
+{
+    LogRing& ring                = getRing();
+    std::vector<LogSink*>& sinks = getSinks();
+    bool written                 = false;
+
+    while (LogSlot* slot = ring.front())
+    {
+        for (LogSink* sink : sinks)
+            sink->write(slot->level, slot->time, std::string_view(slot->message, slot->length));
+
+        ring.pop(slot);
+        written = true;
+    }
+
+    size_t dropped = ring.droppedMessages.exchange(0);
+
+    if (dropped > 0)
+    {
+        std::string message = fmt::format("{} log messages dropped, the logger could not keep up", dropped);
+
+        for (LogSink* sink : sinks)
+            sink->write(LogLevel::WARNING, getCPUTimeUsec(), message);
+
+        written = true;
+    }
+
+    if (written)
+    {
+        for (LogSink* sink : sinks)
+            sink->flush();
+    }
+
+    return written;
+}
+
+static void threadMain()
+{
+    while (!stopping)
+    {
+        bool written;
+
+        {
+            std::unique_lock<std::mutex> lock(drainMutex);
+            written = drain();
+        }
+
+        if (!written)
+            std::this_thread::sleep_for(std::chrono::milliseconds(LOG_DRAIN_PERIOD));
+    }
+}
+
 void Logger::setLogLevel(LogLevel newLogLevel)
 {
     Logger::logLevel = newLogLevel;
 }
 
+LogLevel Logger::getLogLevel()
+{
+    return Logger::logLevel;
+}
+
+void Logger::setAsynchronous(bool enabled)
+{
+    if (enabled == asynchronous)
+        return;
+
+    if (enabled)
+    {
+        stopping    = false;
+        getThread() = std::thread(threadMain);
+    }
+    else
+    {
+        stopping = true;
+        getThread().join();
+    }
+
+    asynchronous = enabled;
+
+    Logger::flush();
+}
+
+void Logger::flush()
+{
+    std::unique_lock<std::mutex> lock(drainMutex);
+    drain();
+}
+
+void Logger::addSink(LogSink* sink)
+{
+    std::unique_lock<std::mutex> lock(drainMutex);
+    getSinks().push_back(sink);
+}
+
+void Logger::removeSink(LogSink* sink)
+{
+    std::unique_lock<std::mutex> lock(drainMutex);
+    std::vector<LogSink*>& sinks = getSinks();
+    sinks.erase(std::remove(sinks.begin(), sinks.end(), sink), sinks.end());
+}
+
+ConsoleLogSink* Logger::getConsoleSink()
+{
+    return getDefaultConsoleSink();
+}
+
+void Logger::write(LogLevel level, const char* message, size_t length)
+{
+    LogRing& ring = getRing();
+
+    if (!ring.push(level, message, length))
+    {
+        // Make room ourselves when synchronous, never wait for the logger thread
+        if (asynchronous)
+        {
+            ring.droppedMessages++;
+            return;
+        }
+
+        Logger::flush();
+
+        if (!ring.push(level, message, length))
+        {
+            ring.droppedMessages++;
+            return;
+        }
+    }
+
+    // Errors are usually followed by a crash, don't lose them
+    if (!asynchronous || level == LogLevel::ERROR)
+        Logger::flush();
+}
+
 } // namespace brls
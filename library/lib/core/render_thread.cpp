@@ -0,0 +1,280 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/render_thread.hpp>
+#include <cstring>
+#include <memory>
+
+namespace brls
+{
+
+RenderThread::RenderThread(VideoContext* videoContext, unsigned depth)
+    : videoContext(videoContext)
+    , vg(videoContext->getNVGContext())
+    , depth(depth)
+{
+    // Forward the texture callbacks, frames go through nvgSubmitFrame()
+    NVGparams* params = nvgInternalParams(this->vg);
+    this->realParams  = *params;
+
+    params->userPtr              = this;
+    params->renderCreateTexture  = RenderThread::createTexture;
+    params->renderDeleteTexture  = RenderThread::deleteTexture;
+    params->renderUpdateTexture  = RenderThread::updateTexture;
+    params->renderGetTextureSize = RenderThread::getTextureSize;
+    params->renderViewport       = RenderThread::viewport;
+    params->renderCancel         = RenderThread::cancel;
+    params->renderFlush          = RenderThread::flush;
+
+    // Glyphs keep being added to the current font atlas, which was created before
+    int fontImage = nvgInternalFontImage(this->vg);
+    int width, height;
+
+    if (fontImage != 0 && this->realParams.renderGetTextureSize(this->realParams.userPtr, fontImage, &width, &height))
+        this->textures[fontImage] = TextureLayout { NVG_TEXTURE_ALPHA, width };
+
+    this->videoContext->makeCurrent(false);
+    this->thread = std::thread(&RenderThread::threadMain, this);
+}
+
+RenderThread::~RenderThread()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->wakeCondition.notify_one();
+    this->thread.join();
+
+    this->videoContext->makeCurrent(true);
+    *nvgInternalParams(this->vg) = this->realParams;
+
+    for (NVGframe* frame : this->frames)
+        nvgDeleteFrame(frame);
+
+    // Run what the render thread posted last
+    this->runMainThreadTasks();
+}
+
+NVGframe* RenderThread::acquireFrame()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->doneCondition.wait(lock, [this] { return this->framesInFlight < this->depth; });
+
+    this->framesInFlight++;
+
+    if (this->freeFrames.empty())
+    {
+        NVGframe* frame = nvgCreateFrame();
+        this->frames.push_back(frame);
+        return frame;
+    }
+
+    NVGframe* frame = this->freeFrames.back();
+    this->freeFrames.pop_back();
+    return frame;
+}
+
+void RenderThread::submitFrame(NVGframe* frame, NVGcolor clearColor)
+{
+    this->push(Item { frame, clearColor, nullptr });
+}
+
+void RenderThread::runSync(std::function<void()> task)
+{
+    if (this->isRenderThread())
+    {
+        task();
+        return;
+    }
+
+    bool done = false;
+
+    this->push(Item { nullptr, {}, [this, &task, &done] {
+                         task();
+
+                         std::unique_lock<std::mutex> lock(this->mutex);
+                         done = true;
+                         this->doneCondition.notify_all();
+                     } });
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->doneCondition.wait(lock, [&done] { return done; });
+}
+
+void RenderThread::runAsync(std::function<void()> task)
+{
+    this->push(Item { nullptr, {}, task });
+}
+
+void RenderThread::push(Item item)
+{
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->queue.push_back(item);
+    }
+
+    this->wakeCondition.notify_one();
+}
+
+void RenderThread::postToMainThread(std::function<void()> task)
+{
+    std::unique_lock<std::mutex> lock(this->mainThreadTasksMutex);
+    this->mainThreadTasks.push_back(task);
+}
+
+void RenderThread::runMainThreadTasks()
+{
+    std::vector<std::function<void()>> tasks;
+
+    {
+        std::unique_lock<std::mutex> lock(this->mainThreadTasksMutex);
+        tasks.swap(this->mainThreadTasks);
+    }
+
+    for (std::function<void()>& task : tasks)
+        task();
+}
+
+bool RenderThread::isRenderThread()
+{
+    return std::this_thread::get_id() == this->thread.get_id();
+}
+
+unsigned RenderThread::getDepth()
+{
+    return this->depth;
+}
+
+void RenderThread::threadMain()
+{
+    this->videoContext->makeCurrent(true);
+
+    while (true)
+    {
+        Item item;
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->wakeCondition.wait(lock, [this] { return this->stopping || !this->queue.empty(); });
+
+            // Queued frames and tasks are always processed before stopping
+            if (this->queue.empty())
+                break;
+
+            item = this->queue.front();
+            this->queue.pop_front();
+        }
+
+        if (!item.frame)
+        {
+            item.task();
+            continue;
+        }
+
+        this->videoContext->beginFrame();
+        this->videoContext->clear(item.clearColor);
+        nvgSubmitFrame(this->vg, item.frame, &this->realParams);
+        this->videoContext->endFrame();
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->freeFrames.push_back(item.frame);
+            this->framesInFlight--;
+        }
+
+        this->doneCondition.notify_all();
+    }
+
+    this->videoContext->makeCurrent(false);
+}
+
+int RenderThread::createTexture(void* userPtr, int type, int w, int h, int imageFlags, const unsigned char* data)
+{
+    RenderThread* self = (RenderThread*)userPtr;
+    int image          = 0;
+
+    self->runSync([&] { image = self->realParams.renderCreateTexture(self->realParams.userPtr, type, w, h, imageFlags, data); });
+
+    if (image != 0)
+        self->textures[image] = TextureLayout { type, w };
+
+    return image;
+}
+
+int RenderThread::deleteTexture(void* userPtr, int image)
+{
+    RenderThread* self = (RenderThread*)userPtr;
+    self->textures.erase(image);
+
+    // The texture might still be used by a queued frame
+    self->runAsync([self, image] { self->realParams.renderDeleteTexture(self->realParams.userPtr, image); });
+
+    return 1;
+}
+
+int RenderThread::updateTexture(void* userPtr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+    RenderThread* self = (RenderThread*)userPtr;
+    auto it            = self->textures.find(image);
+
+    // Images created before the render thread started have an unknown layout, wait for the upload instead
+    if (it == self->textures.end())
+    {
+        int result = 0;
+        self->runSync([&] { result = self->realParams.renderUpdateTexture(self->realParams.userPtr, image, x, y, w, h, data); });
+        return result;
+    }
+
+    // The renderers read whole rows of the texture, from the row y of the given buffer:
+    // copy these rows at the same place in a buffer that is only allocated up to them
+    size_t stride = (size_t)it->second.width * (it->second.type == NVG_TEXTURE_RGBA ? 4 : 1);
+    size_t offset = (size_t)y * stride;
+    std::shared_ptr<unsigned char> pixels(new unsigned char[offset + (size_t)h * stride], std::default_delete<unsigned char[]>());
+    std::memcpy(pixels.get() + offset, data + offset, (size_t)h * stride);
+
+    self->runAsync([self, image, x, y, w, h, pixels] { self->realParams.renderUpdateTexture(self->realParams.userPtr, image, x, y, w, h, pixels.get()); });
+
+    return 1;
+}
+
+int RenderThread::getTextureSize(void* userPtr, int image, int* w, int* h)
+{
+    RenderThread* self = (RenderThread*)userPtr;
+    int result         = 0;
+
+    self->runSync([&] { result = self->realParams.renderGetTextureSize(self->realParams.userPtr, image, w, h); });
+
+    return result;
+}
+
+void RenderThread::viewport(void* userPtr, float width, float height, float devicePixelRatio)
+{
+    // Set by nvgSubmitFrame() on the render thread
+}
+
+void RenderThread::cancel(void* userPtr)
+{
+    // Nothing was submitted yet
+}
+
+void RenderThread::flush(void* userPtr)
+{
+    // Done by nvgSubmitFrame() on the render thread
+}
+
+} // namespace brls
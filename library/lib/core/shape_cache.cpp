@@ -0,0 +1,181 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/shape_cache.hpp>
+#include <functional>
+
+// Maximum number of cached shapes, shapes are drawn without the cache past that
+#define SHAPE_CACHE_MAX_ENTRIES 256
+
+// Number of frames a shape stays in the cache without being drawn
+#define SHAPE_CACHE_MAX_AGE 120
+
+namespace brls
+{
+
+bool ShapeCache::Key::operator==(const Key& other) const
+{
+    return this->type == other.type && this->width == other.width && this->height == other.height && this->radius == other.radius && this->param == other.param;
+}
+
+size_t ShapeCache::KeyHash::operator()(const Key& key) const
+{
+    std::hash<float> hash;
+
+    size_t seed = (size_t)key.type;
+    for (float value : { key.width, key.height, key.radius, key.param })
+        seed ^= hash(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+    return seed;
+}
+
+void ShapeCache::fillRoundedRect(NVGcontext* vg, float x, float y, float width, float height, float radius)
+{
+    ShapeCache::draw(vg, { ShapeType::ROUNDED_RECT_FILL, width, height, radius, 0.0f }, x, y);
+}
+
+void ShapeCache::strokeRoundedRect(NVGcontext* vg, float x, float y, float width, float height, float radius, float strokeWidth)
+{
+    nvgStrokeWidth(vg, strokeWidth);
+    ShapeCache::draw(vg, { ShapeType::ROUNDED_RECT_STROKE, width, height, radius, strokeWidth }, x, y);
+}
+
+void ShapeCache::fillShadow(NVGcontext* vg, float x, float y, float width, float height, float radius, float offset)
+{
+    ShapeCache::draw(vg, { ShapeType::SHADOW, width, height, radius, offset }, x, y);
+}
+
+void ShapeCache::buildPath(NVGcontext* vg, Key key, float x, float y)
+{
+    nvgBeginPath(vg);
+
+    switch (key.type)
+    {
+        case ShapeType::ROUNDED_RECT_FILL:
+        case ShapeType::ROUNDED_RECT_STROKE:
+            nvgRoundedRect(vg, x, y, key.width, key.height, key.radius);
+            break;
+        case ShapeType::SHADOW:
+            nvgRect(vg, x - key.param, y - key.param, key.width + key.param * 2, key.height + key.param * 3);
+            nvgRoundedRect(vg, x, y, key.width, key.height, key.radius);
+            nvgPathWinding(vg, NVG_HOLE);
+            break;
+    }
+}
+
+void ShapeCache::drawPath(NVGcontext* vg, Key key, float x, float y)
+{
+    ShapeCache::buildPath(vg, key, x, y);
+
+    if (key.type == ShapeType::ROUNDED_RECT_STROKE)
+        nvgStroke(vg);
+    else
+        nvgFill(vg);
+}
+
+void ShapeCache::drawPrimitive(NVGcontext* vg, Key key, float x, float y)
+{
+    switch (key.type)
+    {
+        case ShapeType::ROUNDED_RECT_FILL:
+            nvgFillRoundedRect(vg, x, y, key.width, key.height, key.radius);
+            break;
+        case ShapeType::ROUNDED_RECT_STROKE:
+            nvgStrokeRoundedRect(vg, x, y, key.width, key.height, key.radius);
+            break;
+        case ShapeType::SHADOW:
+            nvgFillRoundedRectShadow(vg, x, y, key.width, key.height, key.radius, x - key.param, y - key.param, key.width + key.param * 2, key.height + key.param * 3);
+            break;
+    }
+}
+
+void ShapeCache::draw(NVGcontext* vg, Key key, float x, float y)
+{
+    if (nvgInternalParams(vg)->renderShape)
+    {
+        ShapeCache::drawPrimitive(vg, key, x, y);
+        return;
+    }
+
+    bool stroke = key.type == ShapeType::ROUNDED_RECT_STROKE;
+    auto it     = ShapeCache::entries.find(key);
+
+    if (it == ShapeCache::entries.end())
+    {
+        if (ShapeCache::entries.size() >= SHAPE_CACHE_MAX_ENTRIES)
+        {
+            ShapeCache::drawPath(vg, key, x, y);
+            return;
+        }
+
+        it = ShapeCache::entries.insert({ key, Entry { nullptr, 0 } }).first;
+    }
+
+    Entry& entry    = it->second;
+    entry.lastFrame = ShapeCache::currentFrame;
+
+    if (entry.geometry)
+    {
+        if (stroke ? nvgStrokeGeometry(vg, entry.geometry, x, y) : nvgFillGeometry(vg, entry.geometry, x, y))
+            return;
+
+        // The scale changed since the geometry was created
+        nvgDeleteGeometry(entry.geometry);
+    }
+
+    ShapeCache::buildPath(vg, key, 0.0f, 0.0f);
+    entry.geometry = stroke ? nvgCreateStrokeGeometry(vg) : nvgCreateFillGeometry(vg);
+
+    if (!entry.geometry)
+    {
+        ShapeCache::entries.erase(it);
+        ShapeCache::drawPath(vg, key, x, y);
+        return;
+    }
+
+    if (stroke)
+        nvgStrokeGeometry(vg, entry.geometry, x, y);
+    else
+        nvgFillGeometry(vg, entry.geometry, x, y);
+}
+
+void ShapeCache::frame()
+{
+    ShapeCache::currentFrame++;
+
+    for (auto it = ShapeCache::entries.begin(); it != ShapeCache::entries.end();)
+    {
+        if (ShapeCache::currentFrame - it->second.lastFrame > SHAPE_CACHE_MAX_AGE)
+        {
+            nvgDeleteGeometry(it->second.geometry);
+            it = ShapeCache::entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ShapeCache::clear()
+{
+    for (auto& entry : ShapeCache::entries)
+        nvgDeleteGeometry(entry.second.geometry);
+
+    ShapeCache::entries.clear();
+}
+
+} // namespace brls
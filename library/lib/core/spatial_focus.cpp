@@ -0,0 +1,324 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/box.hpp>
+#include <borealis/core/spatial_focus.hpp>
+#include <cmath>
+
+// Size of one grid cell, in pixels
+#define SPATIAL_FOCUS_CELL_SIZE 128.0f
+
+// How much the distance along the pressed direction weighs
+// compared to the distance on the other axis when scoring candidates
+#define SPATIAL_FOCUS_MAJOR_AXIS_WEIGHT 13.0f
+
+// Overlap tolerated between the current view and a candidate, in pixels
+#define SPATIAL_FOCUS_OVERLAP_TOLERANCE 1.0f
+
+namespace brls
+{
+
+static int32_t getCellCoordinate(float value)
+{
+    return (int32_t)std::floor(value / SPATIAL_FOCUS_CELL_SIZE);
+}
+
+static uint64_t getCellKey(int32_t x, int32_t y)
+{
+    return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
+
+SpatialFocusIndex::SpatialFocusIndex(Box* root)
+    : root(root)
+{
+}
+
+SpatialFocusIndex::~SpatialFocusIndex()
+{
+    for (auto& entry : this->entries)
+        entry.first->setSpatialFocusIndex(nullptr);
+}
+
+void SpatialFocusIndex::add(View* view)
+{
+    this->addEntry(view);
+
+    // Nested spatial navigation boxes have their own index
+    Box* box = dynamic_cast<Box*>(view);
+    if (box && !box->hasSpatialNavigation())
+    {
+        for (View* child : box->getChildren())
+            this->add(child);
+    }
+}
+
+void SpatialFocusIndex::remove(View* view)
+{
+    if (view->getSpatialFocusIndex() != this)
+        return;
+
+    this->removeEntry(view);
+
+    Box* box = dynamic_cast<Box*>(view);
+    if (box && !box->hasSpatialNavigation())
+    {
+        for (View* child : box->getChildren())
+            this->remove(child);
+    }
+}
+
+void SpatialFocusIndex::invalidate(View* view)
+{
+    this->dirtyViews.insert(view);
+}
+
+void SpatialFocusIndex::addEntry(View* view)
+{
+    SpatialFocusIndex* previousIndex = view->getSpatialFocusIndex();
+
+    if (previousIndex != this)
+    {
+        if (previousIndex)
+            previousIndex->removeEntry(view);
+
+        this->entries[view] = Entry();
+        view->setSpatialFocusIndex(this);
+    }
+
+    this->dirtyViews.insert(view);
+}
+
+void SpatialFocusIndex::removeEntry(View* view)
+{
+    auto it = this->entries.find(view);
+
+    if (it != this->entries.end())
+    {
+        this->removeFromGrid(view, &it->second);
+        this->entries.erase(it);
+    }
+
+    this->dirtyViews.erase(view);
+    view->setSpatialFocusIndex(nullptr);
+}
+
+void SpatialFocusIndex::removeFromGrid(View* view, Entry* entry)
+{
+    if (!entry->inGrid)
+        return;
+
+    std::vector<View*>& cell = this->cells[entry->cell];
+
+    for (size_t i = 0; i < cell.size(); i++)
+    {
+        if (cell[i] == view)
+        {
+            cell[i] = cell.back();
+            cell.pop_back();
+            break;
+        }
+    }
+
+    if (cell.empty())
+        this->cells.erase(entry->cell);
+
+    entry->inGrid = false;
+}
+
+void SpatialFocusIndex::getFrame(View* view, float* x, float* y, float* width, float* height)
+{
+    *x      = view->getX() - this->root->getX();
+    *y      = view->getY() - this->root->getY();
+    *width  = view->getWidth();
+    *height = view->getHeight();
+}
+
+void SpatialFocusIndex::refreshEntry(View* view, Entry* entry)
+{
+    this->getFrame(view, &entry->x, &entry->y, &entry->width, &entry->height);
+
+    if (!view->isFocusable())
+    {
+        this->removeFromGrid(view, entry);
+        return;
+    }
+
+    // Views are put in the cell containing their center
+    int32_t cellX = getCellCoordinate(entry->x + entry->width / 2);
+    int32_t cellY = getCellCoordinate(entry->y + entry->height / 2);
+    uint64_t cell = getCellKey(cellX, cellY);
+
+    if (entry->inGrid && entry->cell == cell)
+        return;
+
+    this->removeFromGrid(view, entry);
+
+    this->cells[cell].push_back(view);
+    entry->inGrid = true;
+    entry->cell   = cell;
+
+    // Bounds only grow, empty cells are skipped when looking up
+    if (this->maxCellX < this->minCellX)
+    {
+        this->minCellX = this->maxCellX = cellX;
+        this->minCellY = this->maxCellY = cellY;
+    }
+    else
+    {
+        this->minCellX = std::min(this->minCellX, cellX);
+        this->maxCellX = std::max(this->maxCellX, cellX);
+        this->minCellY = std::min(this->minCellY, cellY);
+        this->maxCellY = std::max(this->maxCellY, cellY);
+    }
+}
+
+void SpatialFocusIndex::refresh()
+{
+    if (this->dirtyViews.empty())
+        return;
+
+    // A layout change of a box moves all of its children, so refresh the whole subtree
+    std::vector<View*> stack(this->dirtyViews.begin(), this->dirtyViews.end());
+    std::unordered_set<View*> refreshed;
+
+    this->dirtyViews.clear();
+
+    while (!stack.empty())
+    {
+        View* view = stack.back();
+        stack.pop_back();
+
+        if (view->getSpatialFocusIndex() != this || !refreshed.insert(view).second)
+            continue;
+
+        auto it = this->entries.find(view);
+        if (it == this->entries.end())
+            continue;
+
+        this->refreshEntry(view, &it->second);
+
+        Box* box = dynamic_cast<Box*>(view);
+        if (box && !box->hasSpatialNavigation())
+        {
+            for (View* child : box->getChildren())
+                stack.push_back(child);
+        }
+    }
+}
+
+View* SpatialFocusIndex::getNextFocus(FocusDirection direction, View* currentFocus)
+{
+    this->refresh();
+
+    if (this->maxCellX < this->minCellX)
+        return nullptr;
+
+    // Current frame
+    float x, y, width, height;
+    auto current = this->entries.find(currentFocus);
+
+    if (current != this->entries.end())
+    {
+        x      = current->second.x;
+        y      = current->second.y;
+        width  = current->second.width;
+        height = current->second.height;
+    }
+    else
+    {
+        this->getFrame(currentFocus, &x, &y, &width, &height);
+    }
+
+    float centerX = x + width / 2;
+    float centerY = y + height / 2;
+
+    bool horizontal = direction == FocusDirection::LEFT || direction == FocusDirection::RIGHT;
+    int32_t step    = (direction == FocusDirection::RIGHT || direction == FocusDirection::DOWN) ? 1 : -1;
+
+    int32_t firstLine = horizontal ? getCellCoordinate(centerX) : getCellCoordinate(centerY);
+    int32_t lastLine  = horizontal ? (step > 0 ? this->maxCellX : this->minCellX) : (step > 0 ? this->maxCellY : this->minCellY);
+
+    int32_t firstCross = horizontal ? this->minCellY : this->minCellX;
+    int32_t lastCross  = horizontal ? this->maxCellY : this->maxCellX;
+
+    View* nextFocus = nullptr;
+    float bestScore = INFINITY;
+
+    // Sweep the grid line by line in the pressed direction, stopping as soon as
+    // the views of the next line are too far to beat the best candidate
+    for (int32_t line = firstLine; step > 0 ? line <= lastLine : line >= lastLine; line += step)
+    {
+        float lineStart   = (step > 0 ? line : line + 1) * SPATIAL_FOCUS_CELL_SIZE;
+        float minDistance = std::max(0.0f, (lineStart - (horizontal ? centerX : centerY)) * step);
+
+        if (minDistance * minDistance * SPATIAL_FOCUS_MAJOR_AXIS_WEIGHT >= bestScore)
+            break;
+
+        for (int32_t cross = firstCross; cross <= lastCross; cross++)
+        {
+            auto cell = this->cells.find(horizontal ? getCellKey(line, cross) : getCellKey(cross, line));
+
+            if (cell == this->cells.end())
+                continue;
+
+            for (View* candidate : cell->second)
+            {
+                if (candidate == currentFocus || !candidate->isFocusable())
+                    continue;
+
+                Entry& entry = this->entries[candidate];
+
+                // The candidate must be entirely in the pressed direction
+                bool inDirection = false;
+                switch (direction)
+                {
+                    case FocusDirection::RIGHT:
+                        inDirection = entry.x >= x + width - SPATIAL_FOCUS_OVERLAP_TOLERANCE;
+                        break;
+                    case FocusDirection::LEFT:
+                        inDirection = entry.x + entry.width <= x + SPATIAL_FOCUS_OVERLAP_TOLERANCE;
+                        break;
+                    case FocusDirection::DOWN:
+                        inDirection = entry.y >= y + height - SPATIAL_FOCUS_OVERLAP_TOLERANCE;
+                        break;
+                    case FocusDirection::UP:
+                        inDirection = entry.y + entry.height <= y + SPATIAL_FOCUS_OVERLAP_TOLERANCE;
+                        break;
+                }
+
+                if (!inDirection)
+                    continue;
+
+                float candidateCenterX = entry.x + entry.width / 2;
+                float candidateCenterY = entry.y + entry.height / 2;
+
+                float major = horizontal ? std::abs(candidateCenterX - centerX) : std::abs(candidateCenterY - centerY);
+                float minor = horizontal ? std::abs(candidateCenterY - centerY) : std::abs(candidateCenterX - centerX);
+                float score = major * major * SPATIAL_FOCUS_MAJOR_AXIS_WEIGHT + minor * minor;
+
+                if (score < bestScore)
+                {
+                    bestScore = score;
+                    nextFocus = candidate;
+                }
+            }
+        }
+    }
+
+    return nextFocus;
+}
+
+} // namespace brls
@@ -0,0 +1,123 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/thread_pool.hpp>
+
+#ifdef __SWITCH__
+#include <switch.h>
+
+// Number of cores available to applications, the main thread runs on the first one
+#define THREAD_POOL_SWITCH_CORES 3
+#endif
+
+namespace brls
+{
+
+ThreadPool::ThreadPool(unsigned workers)
+{
+    this->next = 0;
+
+    for (unsigned i = 0; i < workers; i++)
+        this->workers.emplace_back(&ThreadPool::workerMain, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->wakeCondition.notify_all();
+
+    for (std::thread& worker : this->workers)
+        worker.join();
+}
+
+void ThreadPool::parallelFor(size_t count, std::function<void(size_t)> job)
+{
+    if (count == 0)
+        return;
+
+    // Not worth waking the workers up
+    if (this->workers.empty() || count == 1)
+    {
+        for (size_t i = 0; i < count; i++)
+            job(i);
+
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        this->job         = job;
+        this->count       = count;
+        this->next        = 0;
+        this->busyWorkers = this->workers.size();
+        this->generation++;
+    }
+
+    this->wakeCondition.notify_all();
+
+    this->runJobs();
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->doneCondition.wait(lock, [this] { return this->busyWorkers == 0; });
+}
+
+void ThreadPool::runJobs()
+{
+    for (size_t i = this->next++; i < this->count; i = this->next++)
+        this->job(i);
+}
+
+void ThreadPool::workerMain(unsigned index)
+{
+#ifdef __SWITCH__
+    // Threads are all created on the core of their parent, spread them on the other ones
+    int core = (index + 1) % THREAD_POOL_SWITCH_CORES;
+    svcSetThreadCoreMask(CUR_THREAD_HANDLE, core, 1 << core);
+#endif
+
+    uint64_t seenGeneration = 0;
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (true)
+    {
+        this->wakeCondition.wait(lock, [this, seenGeneration] { return this->stopping || this->generation != seenGeneration; });
+
+        if (this->stopping)
+            return;
+
+        seenGeneration = this->generation;
+
+        lock.unlock();
+        this->runJobs();
+        lock.lock();
+
+        if (--this->busyWorkers == 0)
+            this->doneCondition.notify_one();
+    }
+}
+
+unsigned ThreadPool::getWorkersCount()
+{
+    return this->workers.size();
+}
+
+} // namespace brls
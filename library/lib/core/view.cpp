@@ -15,6 +15,7 @@
     limitations under the License.
 */
 
+#include <cxxabi.h>
 #include <math.h>
 
 #include <algorithm>
@@ -23,8 +24,11 @@
 #include <borealis/core/box.hpp>
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/input.hpp>
+#include <borealis/core/shape_cache.hpp>
+#include <borealis/core/spatial_focus.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/core/view.hpp>
+#include <mutex>
 
 using namespace brls::literals;
 
@@ -41,10 +45,50 @@ static bool startsWith(const std::string& data, const std::string& prefix)
     return data.rfind(prefix, 0) == 0;
 }
 
+// Stored in front of every view to know where it has been allocated
+struct alignas(std::max_align_t) ViewAllocationHeader
+{
+    ViewArena* arena;
+};
+
+void* View::operator new(size_t size)
+{
+    ViewArena* arena = ViewArena::getCurrent();
+    size_t totalSize = sizeof(ViewAllocationHeader) + size;
+
+    ViewAllocationHeader* header = (ViewAllocationHeader*)(arena ? arena->allocate(totalSize) : ::operator new(totalSize));
+    header->arena                = arena;
+
+    return header + 1;
+}
+
+void View::operator delete(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    // Memory allocated in an arena is released with the arena
+    ViewAllocationHeader* header = (ViewAllocationHeader*)ptr - 1;
+
+    if (!header->arena)
+        ::operator delete(header);
+}
+
 View::View()
 {
     // Instantiate and prepare YGNode
-    this->ygNode = YGNodeNew();
+    ViewArena* arena = ViewArena::getCurrent();
+
+    if (arena)
+    {
+        this->ygNode        = new (arena->allocate(sizeof(YGNode), alignof(YGNode))) YGNode(YGConfigGetDefault());
+        this->ygNodeInArena = true;
+    }
+    else
+    {
+        this->ygNode = YGNodeNew();
+    }
+
     YGNodeSetContext(this->ygNode, this);
 
     YGNodeStyleSetWidthAuto(this->ygNode);
@@ -83,15 +127,15 @@ float View::getAlpha(bool child)
 NVGcolor View::a(NVGcolor color)
 {
     NVGcolor newColor = color; // copy
-    newColor.a *= this->getAlpha();
+    newColor.a *= this->frameAlpha;
     return newColor;
 }
 
 NVGpaint View::a(NVGpaint paint)
 {
     NVGpaint newPaint = paint; // copy
-    newPaint.innerColor.a *= this->getAlpha();
-    newPaint.outerColor.a *= this->getAlpha();
+    newPaint.innerColor.a *= this->frameAlpha;
+    newPaint.outerColor.a *= this->frameAlpha;
     return newPaint;
 }
 
@@ -100,11 +144,18 @@ void View::frame(FrameContext* ctx)
     if (this->visibility != Visibility::VISIBLE)
         return;
 
+    // Skip the whole subtree if it's transparent
+    float parentAlpha = ctx->alpha;
+    this->frameAlpha  = parentAlpha * this->alpha;
+
+    if (this->frameAlpha <= 0.0f)
+        return;
+
+    ctx->alpha = this->frameAlpha;
+
     Style style    = Application::getStyle();
     Theme oldTheme = ctx->theme;
 
-    nvgSave(ctx->vg);
-
     // Theme override
     if (this->themeOverride)
         ctx->theme = *themeOverride;
@@ -114,7 +165,7 @@ void View::frame(FrameContext* ctx)
     float width  = this->getWidth();
     float height = this->getHeight();
 
-    if (this->alpha > 0.0f && this->collapseState != 0.0f)
+    if (this->collapseState != 0.0f)
     {
         // Draw background
         this->drawBackground(ctx->vg, ctx, style);
@@ -137,10 +188,7 @@ void View::frame(FrameContext* ctx)
 
         // Collapse clipping
         if (this->collapseState < 1.0f)
-        {
-            nvgSave(ctx->vg);
-            nvgIntersectScissor(ctx->vg, x, y, width, height * this->collapseState);
-        }
+            ctx->pushScissor(x, y, width, height * this->collapseState);
 
         // Draw the view
         this->draw(ctx->vg, x, y, width, height, style, ctx);
@@ -156,14 +204,14 @@ void View::frame(FrameContext* ctx)
 
         //Reset clipping
         if (this->collapseState < 1.0f)
-            nvgRestore(ctx->vg);
+            ctx->popScissor();
     }
 
     // Cleanup
     if (this->themeOverride)
         ctx->theme = oldTheme;
 
-    nvgRestore(ctx->vg);
+    ctx->alpha = parentAlpha;
 }
 
 void View::resetClickAnimation()
@@ -202,14 +250,17 @@ void View::drawClickAnimation(NVGcontext* vg, FrameContext* ctx, float x, float
     color.a *= this->clickAlpha;
 
     nvgFillColor(vg, a(color));
-    nvgBeginPath(vg);
 
     if (this->cornerRadius > 0.0f)
-        nvgRoundedRect(vg, x, y, width, height, this->cornerRadius);
+    {
+        ShapeCache::fillRoundedRect(vg, x, y, width, height, this->cornerRadius);
+    }
     else
+    {
+        nvgBeginPath(vg);
         nvgRect(vg, x, y, width, height);
-
-    nvgFill(vg);
+        nvgFill(vg);
+    }
 }
 
 void View::drawLine(FrameContext* ctx, float x, float y, float width, float height)
@@ -319,11 +370,8 @@ void View::drawWireframe(FrameContext* ctx, float x, float y, float width, float
 
 void View::drawBorder(NVGcontext* vg, FrameContext* ctx, Style style, float x, float y, float width, float height)
 {
-    nvgBeginPath(vg);
     nvgStrokeColor(vg, this->borderColor);
-    nvgStrokeWidth(vg, this->borderThickness);
-    nvgRoundedRect(vg, x, y, width, height, this->cornerRadius);
-    nvgStroke(vg);
+    ShapeCache::strokeRoundedRect(vg, x, y, width, height, this->cornerRadius, this->borderThickness);
 }
 
 void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, float x, float y, float width, float height)
@@ -354,17 +402,8 @@ void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, float x, f
         this->cornerRadius * 2, shadowFeather,
         RGBA(0, 0, 0, shadowOpacity * alpha), TRANSPARENT);
 
-    nvgBeginPath(vg);
-    nvgRect(
-        vg,
-        x - shadowOffset,
-        y - shadowOffset,
-        width + shadowOffset * 2,
-        height + shadowOffset * 3);
-    nvgRoundedRect(vg, x, y, width, height, this->cornerRadius);
-    nvgPathWinding(vg, NVG_HOLE);
     nvgFillPaint(vg, shadowPaint);
-    nvgFill(vg);
+    ShapeCache::fillShadow(vg, x, y, width, height, this->cornerRadius, shadowOffset);
 }
 
 void View::collapse(bool animated)
@@ -425,7 +464,9 @@ void View::setAlpha(float alpha)
 
 void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style, bool background)
 {
-    nvgSave(vg);
+    // The highlight is drawn above everything, without scissor
+    NVGscissor scissor;
+    nvgCurrentScissor(vg, &scissor);
     nvgResetScissor(vg);
 
     float padding      = this->highlightPadding;
@@ -473,9 +514,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
         // Background
         NVGcolor highlightBackgroundColor = theme["brls/highlight/background"];
         nvgFillColor(vg, RGBAf(highlightBackgroundColor.r, highlightBackgroundColor.g, highlightBackgroundColor.b, this->highlightAlpha));
-        nvgBeginPath(vg);
-        nvgRoundedRect(vg, x, y, width, height, cornerRadius);
-        nvgFill(vg);
+        ShapeCache::fillRoundedRect(vg, x, y, width, height, cornerRadius);
     }
     else
     {
@@ -488,13 +527,8 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
             cornerRadius * 2, style["brls/highlight/shadow_feather"],
             RGBA(0, 0, 0, style["brls/highlight/shadow_opacity"] * alpha), TRANSPARENT);
 
-        nvgBeginPath(vg);
-        nvgRect(vg, x - shadowOffset, y - shadowOffset,
-            width + shadowOffset * 2, height + shadowOffset * 3);
-        nvgRoundedRect(vg, x, y, width, height, cornerRadius);
-        nvgPathWinding(vg, NVG_HOLE);
         nvgFillPaint(vg, shadowPaint);
-        nvgFill(vg);
+        ShapeCache::fillShadow(vg, x, y, width, height, cornerRadius, shadowOffset);
 
         // Border
         float gradientX, gradientY, color;
@@ -508,7 +542,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
             alpha);
 
         NVGcolor borderColor = theme["brls/highlight/color2"];
-        borderColor.a        = 0.5f * alpha * this->getAlpha();
+        borderColor.a        = 0.5f * alpha * this->frameAlpha;
 
         float strokeWidth = style["brls/highlight/stroke_width"];
 
@@ -522,26 +556,17 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
             strokeWidth * 10, strokeWidth * 40,
             borderColor, TRANSPARENT);
 
-        nvgBeginPath(vg);
         nvgStrokeColor(vg, pulsationColor);
-        nvgStrokeWidth(vg, strokeWidth);
-        nvgRoundedRect(vg, x, y, width, height, cornerRadius);
-        nvgStroke(vg);
+        ShapeCache::strokeRoundedRect(vg, x, y, width, height, cornerRadius, strokeWidth);
 
-        nvgBeginPath(vg);
         nvgStrokePaint(vg, border1Paint);
-        nvgStrokeWidth(vg, strokeWidth);
-        nvgRoundedRect(vg, x, y, width, height, cornerRadius);
-        nvgStroke(vg);
+        ShapeCache::strokeRoundedRect(vg, x, y, width, height, cornerRadius, strokeWidth);
 
-        nvgBeginPath(vg);
         nvgStrokePaint(vg, border2Paint);
-        nvgStrokeWidth(vg, strokeWidth);
-        nvgRoundedRect(vg, x, y, width, height, cornerRadius);
-        nvgStroke(vg);
+        ShapeCache::strokeRoundedRect(vg, x, y, width, height, cornerRadius, strokeWidth);
     }
 
-    nvgRestore(vg);
+    nvgRestoreScissor(vg, &scissor);
 }
 
 void View::setBackground(ViewBackground background)
@@ -597,14 +622,17 @@ void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style)
         case ViewBackground::SHAPE_COLOR:
         {
             nvgFillColor(vg, a(this->backgroundColor));
-            nvgBeginPath(vg);
 
             if (this->cornerRadius > 0.0f)
-                nvgRoundedRect(vg, x, y, width, height, this->cornerRadius);
+            {
+                ShapeCache::fillRoundedRect(vg, x, y, width, height, this->cornerRadius);
+            }
             else
+            {
+                nvgBeginPath(vg);
                 nvgRect(vg, x, y, width, height);
-
-            nvgFill(vg);
+                nvgFill(vg);
+            }
         }
         case ViewBackground::NONE:
             break;
@@ -651,15 +679,154 @@ void View::setActionAvailable(enum ControllerButton button, bool available)
         it->available = available;
 }
 
-void View::setParent(Box* parent, void* parentUserdata)
+static void registerViewId(ViewIdIndex* index, View* view, std::string id)
 {
-    this->parent         = parent;
-    this->parentUserdata = parentUserdata;
+    if (id != "")
+        (*index)[id].push_back(view);
+}
+
+static void unregisterViewId(ViewIdIndex* index, View* view, std::string id)
+{
+    auto it = index->find(id);
+
+    if (it == index->end())
+        return;
+
+    std::vector<View*>& views = it->second;
+    views.erase(std::remove(views.begin(), views.end(), view), views.end());
+
+    if (views.empty())
+        index->erase(it);
+}
+
+void View::setParent(Box* parent, size_t parentIndex)
+{
+    // Leaving a tree: take the IDs of our children out of the root index
+    std::vector<View*> identifiedViews;
+
+    if (this->parent)
+    {
+        ViewIdIndex* rootIndex = this->getRootView()->idIndex;
+
+        if (rootIndex)
+        {
+            std::vector<View*> stack = { this };
+
+            while (!stack.empty())
+            {
+                View* view = stack.back();
+                stack.pop_back();
+
+                if (view->id != "")
+                {
+                    unregisterViewId(rootIndex, view, view->id);
+                    identifiedViews.push_back(view);
+                }
+
+                Box* box = dynamic_cast<Box*>(view);
+                if (box)
+                    stack.insert(stack.end(), box->getChildren().begin(), box->getChildren().end());
+            }
+        }
+    }
+
+    this->parent      = parent;
+    this->parentIndex = parentIndex;
+
+    if (!identifiedViews.empty())
+    {
+        this->idIndex = new ViewIdIndex();
+
+        for (View* view : identifiedViews)
+            registerViewId(this->idIndex, view, view->id);
+    }
+
+    // Joining a tree: merge our index into the root one
+    if (this->parent && this->idIndex)
+    {
+        ViewIdIndex* rootIndex = this->getRootView()->getIdIndex();
+
+        for (auto& pair : *this->idIndex)
+        {
+            std::vector<View*>& views = (*rootIndex)[pair.first];
+            views.insert(views.end(), pair.second.begin(), pair.second.end());
+        }
+
+        delete this->idIndex;
+        this->idIndex = nullptr;
+    }
 }
 
-void* View::getParentUserData()
+View* View::getRootView()
 {
-    return this->parentUserdata;
+    View* root = this;
+
+    while (root->hasParent())
+        root = root->getParent();
+
+    return root;
+}
+
+ViewIdIndex* View::getIdIndex()
+{
+    View* root = this->getRootView();
+
+    if (!root->idIndex)
+        root->idIndex = new ViewIdIndex();
+
+    return root->idIndex;
+}
+
+View* View::searchView(std::string id)
+{
+    if (this->id == id)
+        return this;
+
+    Box* box = dynamic_cast<Box*>(this);
+
+    if (box)
+    {
+        for (View* child : box->getChildren())
+        {
+            View* result = child->searchView(id);
+
+            if (result)
+                return result;
+        }
+    }
+
+    return nullptr;
+}
+
+bool View::isInSubtreeOf(View* view)
+{
+    for (View* parent = this; parent != nullptr; parent = parent->getParent())
+    {
+        if (parent == view)
+            return true;
+    }
+
+    return false;
+}
+
+void View::setParentIndex(size_t parentIndex)
+{
+    this->parentIndex = parentIndex;
+}
+
+size_t View::getParentIndex()
+{
+    return this->parentIndex;
+}
+
+void View::setSpatialFocusIndex(SpatialFocusIndex* index)
+{
+    this->spatialFocusIndex = index;
+}
+
+SpatialFocusIndex* View::getSpatialFocusIndex()
+{
+    return this->spatialFocusIndex;
 }
 
 bool View::isFocused()
@@ -1105,7 +1272,7 @@ void View::show(std::function<void(void)> cb, bool animate, float animationDurat
         return;
     }
 
-    brls::Logger::debug("Showing {}", this->describe());
+    BRLS_LOG_DEBUG("Showing {}", this->describe());
 
     this->hidden = false;
 
@@ -1147,7 +1314,7 @@ void View::hide(std::function<void(void)> cb, bool animated, float animationDura
         return;
     }
 
-    brls::Logger::debug("Hiding {}", this->describe());
+    BRLS_LOG_DEBUG("Hiding {}", this->describe());
 
     this->hidden = true;
     this->fadeIn = false;
@@ -1233,16 +1400,43 @@ std::string View::getCustomNavigationRouteId(FocusDirection direction)
     return this->customFocusById[direction];
 }
 
+std::string_view View::getClassName(std::type_index type)
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::type_index, std::string> classNames;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto it = classNames.find(type);
+    if (it != classNames.end())
+        return it->second;
+
+    // Taken from: https://stackoverflow.com/questions/281818/unmangling-the-result-of-stdtype-infoname/4541470#4541470
+    const char* name = type.name();
+    int status       = 0;
+
+    std::unique_ptr<char, void (*)(void*)> res {
+        abi::__cxa_demangle(name, NULL, NULL, &status),
+        std::free
+    };
+
+    // Map nodes don't move, the returned view stays valid
+    return classNames.emplace(type, (status == 0) ? res.get() : name).first->second;
+}
+
 View::~View()
 {
     this->resetClickAnimation();
 
-    // Parent userdata
-    if (this->parentUserdata)
-    {
-        free(this->parentUserdata);
-        this->parentUserdata = nullptr;
-    }
+    // IDs index
+    if (this->idIndex)
+        delete this->idIndex;
+    else if (this->id != "" && this->hasParent())
+        unregisterViewId(this->getIdIndex(), this, this->id);
+
+    // Spatial focus index
+    if (this->spatialFocusIndex)
+        this->spatialFocusIndex->remove(this);
 
     // Focus sanity check
     if (Application::getCurrentFocus() == this)
@@ -1250,6 +1444,20 @@ View::~View()
 
     for (tinyxml2::XMLDocument* document : this->boundDocuments)
         delete document;
+
+    // YGNode
+    if (this->ygNodeInArena)
+    {
+        if (YGNodeGetOwner(this->ygNode))
+            YGNodeRemoveChild(YGNodeGetOwner(this->ygNode), this->ygNode);
+
+        YGNodeRemoveAllChildren(this->ygNode);
+        this->ygNode->~YGNode();
+    }
+    else
+    {
+        YGNodeFree(this->ygNode);
+    }
 }
 
 std::string View::getStringXMLAttributeValue(std::string value)
@@ -1275,238 +1483,144 @@ std::string View::getFilePathXMLAttributeValue(std::string value)
 }
 
 bool View::applyXMLAttribute(std::string name, std::string value)
+{
+    return this->applyXMLAttributeValue(name, classifyXMLValue(value));
+}
+
+void View::applyXMLAttributes(tinyxml2::XMLElement* element)
+{
+    if (!element)
+        return;
+
+    for (const tinyxml2::XMLAttribute* attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+    {
+        std::string name = attribute->Name();
+        XMLValue value   = classifyXMLValue(attribute->Value());
+
+        if (!this->applyXMLAttributeValue(name, value))
+            this->printXMLAttributeErrorMessage(element->Name(), name, attribute->Value());
+    }
+}
+
+bool View::applyXMLAttributeValue(const std::string& name, const XMLValue& value)
 {
     // String -> string
-    if (this->stringAttributes.count(name) > 0)
+    auto stringAttribute = this->stringAttributes.find(name);
+    if (stringAttribute != this->stringAttributes.end())
     {
-        if (startsWith(value, "@i18n/"))
-        {
-            this->stringAttributes[name](View::getStringXMLAttributeValue(value));
-            return true;
-        }
+        if (value.type == XMLValueType::I18N)
+            stringAttribute->second(getStr(std::string(value.reference)));
+        else
+            stringAttribute->second(std::string(value.raw));
 
-        this->stringAttributes[name](value);
         return true;
     }
 
     // File path -> file path
-    if (startsWith(value, "@res/"))
+    auto filePathAttribute = this->filePathAttributes.find(name);
+    if (value.type == XMLValueType::RESOURCE)
     {
-        std::string path = View::getFilePathXMLAttributeValue(value);
-
-        if (this->filePathAttributes.count(name) > 0)
-        {
-            this->filePathAttributes[name](path);
-            return true;
-        }
-        else
-        {
+        if (filePathAttribute == this->filePathAttributes.end())
             return false; // unknown res
-        }
-    }
-    else
-    {
-        if (this->filePathAttributes.count(name) > 0)
-        {
-            this->filePathAttributes[name](value);
-            return true;
-        }
 
-        // don't return false as it can be anything else
+        filePathAttribute->second(std::string(BRLS_RESOURCES) + std::string(value.reference));
+        return true;
     }
-
-    // Auto -> auto
-    if (value == "auto")
+    else if (filePathAttribute != this->filePathAttributes.end())
     {
-        if (this->autoAttributes.count(name) > 0)
-        {
-            this->autoAttributes[name]();
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        filePathAttribute->second(std::string(value.raw));
+        return true;
     }
 
-    // Ends with px -> float
-    if (endsWith(value, "px"))
+    switch (value.type)
     {
-        // Strip the px and parse the float value
-        std::string newFloat = value.substr(0, value.length() - 2);
-        try
+        // Auto -> auto
+        case XMLValueType::AUTO:
         {
-            float floatValue = std::stof(newFloat);
-            if (this->floatAttributes.count(name) > 0)
-            {
-                this->floatAttributes[name](floatValue);
-                return true;
-            }
-            else
-            {
+            auto attribute = this->autoAttributes.find(name);
+            if (attribute == this->autoAttributes.end())
                 return false;
-            }
+
+            attribute->second();
+            return true;
         }
-        catch (const std::invalid_argument& exception)
+        // Float or px -> float
+        case XMLValueType::FLOAT:
         {
-            return false;
-        }
-    }
+            auto attribute = this->floatAttributes.find(name);
+            if (attribute == this->floatAttributes.end())
+                return false;
 
-    // Ends with % -> percentage
-    if (endsWith(value, "%"))
-    {
-        // Strip the % and parse the float value
-        std::string newFloat = value.substr(0, value.length() - 1);
-        try
+            attribute->second(value.number);
+            return true;
+        }
+        // Percentage -> percentage
+        case XMLValueType::PERCENTAGE:
         {
-            float floatValue = std::stof(newFloat);
-
-            if (floatValue < -100 || floatValue > 100)
+            if (value.number < -100 || value.number > 100)
                 return false;
 
-            if (this->percentageAttributes.count(name) > 0)
-            {
-                this->percentageAttributes[name](floatValue);
-                return true;
-            }
-            else
-            {
+            auto attribute = this->percentageAttributes.find(name);
+            if (attribute == this->percentageAttributes.end())
                 return false;
-            }
-        }
-        catch (const std::invalid_argument& exception)
-        {
-            return false;
-        }
-    }
-    // Starts with @style -> float
-    else if (startsWith(value, "@style/"))
-    {
-        // Parse the style name
-        std::string styleName = value.substr(7); // length of "@style/"
-        float value           = Application::getStyle()[styleName]; // will throw logic_error if the metric doesn't exist
 
-        if (this->floatAttributes.count(name) > 0)
-        {
-            this->floatAttributes[name](value);
+            attribute->second(value.number);
             return true;
         }
-        else
-        {
-            return false;
-        }
-    }
-    // Starts with with # -> color
-    else if (startsWith(value, "#"))
-    {
-        // Parse the color
-        // #RRGGBB format
-        if (value.size() == 7)
+        // @style -> float
+        case XMLValueType::STYLE:
         {
-            unsigned char r, g, b;
-            int result = sscanf(value.c_str(), "#%02hhx%02hhx%02hhx", &r, &g, &b);
-
-            if (result != 3)
+            auto attribute = this->floatAttributes.find(name);
+            if (attribute == this->floatAttributes.end())
                 return false;
-            else if (this->colorAttributes.count(name) > 0)
-            {
-                this->colorAttributes[name](nvgRGB(r, g, b));
-                return true;
-            }
-            else
-            {
-                return false;
-            }
-        }
-        // #RRGGBBAA format
-        else if (value.size() == 9)
-        {
-            unsigned char r, g, b, a;
-            int result = sscanf(value.c_str(), "#%02hhx%02hhx%02hhx%02hhx", &r, &g, &b, &a);
 
-            if (result != 4)
-                return false;
-            else if (this->colorAttributes.count(name) > 0)
-            {
-                this->colorAttributes[name](nvgRGBA(r, g, b, a));
-                return true;
-            }
-            else
-            {
-                return false;
-            }
+            attribute->second(Application::getStyle()[std::string(value.reference)]); // will throw logic_error if the metric doesn't exist
+            return true;
         }
-        else
+        // Color -> color
+        case XMLValueType::COLOR:
         {
-            return false;
-        }
-    }
-    // Starts with @theme -> color
-    else if (startsWith(value, "@theme/"))
-    {
-        // Parse the color name
-        std::string colorName = value.substr(7); // length of "@theme/"
-        NVGcolor value        = Application::getTheme()[colorName]; // will throw logic_error if the color doesn't exist
+            auto attribute = this->colorAttributes.find(name);
+            if (attribute == this->colorAttributes.end())
+                return false;
 
-        if (this->colorAttributes.count(name) > 0)
-        {
-            this->colorAttributes[name](value);
+            attribute->second(value.color);
             return true;
         }
-        else
+        // @theme -> color
+        case XMLValueType::THEME:
         {
-            return false;
-        }
-    }
-    // Equals true or false -> bool
-    else if (value == "true" || value == "false")
-    {
-        bool boolValue = value == "true" ? true : false;
+            auto attribute = this->colorAttributes.find(name);
+            if (attribute == this->colorAttributes.end())
+                return false;
 
-        if (this->boolAttributes.count(name) > 0)
-        {
-            this->boolAttributes[name](boolValue);
+            attribute->second(Application::getTheme()[std::string(value.reference)]); // will throw logic_error if the color doesn't exist
             return true;
         }
-        else
+        // Bool -> bool
+        case XMLValueType::BOOL:
         {
-            return false;
-        }
-    }
+            auto attribute = this->boolAttributes.find(name);
+            if (attribute == this->boolAttributes.end())
+                return false;
 
-    // Valid float -> float, otherwise unknown attribute
-    try
-    {
-        float newValue = std::stof(value);
-        if (this->floatAttributes.count(name) > 0)
-        {
-            this->floatAttributes[name](newValue);
+            attribute->second(value.boolean);
             return true;
         }
-        else
-        {
+        default:
             return false;
-        }
-    }
-    catch (const std::invalid_argument& exception)
-    {
-        return false;
     }
 }
 
-void View::applyXMLAttributes(tinyxml2::XMLElement* element)
+void View::applyBXMLAttributes(BXMLElement element)
 {
-    if (!element)
-        return;
+    const BXMLAttribute* attributes = element.getAttributes();
+    size_t count                    = element.getAttributesCount();
 
-    for (const tinyxml2::XMLAttribute* attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+    for (size_t i = 0; i < count; i++)
     {
-        std::string name  = attribute->Name();
-        std::string value = std::string(attribute->Value());
-
-        if (!this->applyXMLAttribute(name, value))
-            this->printXMLAttributeErrorMessage(element, name, value);
+        if (!this->applyXMLAttributeValue(attributes[i].name, attributes[i].value))
+            this->printXMLAttributeErrorMessage(std::string(element.getName()), attributes[i].name, std::string(attributes[i].value.raw));
     }
 }
 
@@ -1540,6 +1654,11 @@ View* View::createFromXMLString(std::string xml)
 
 View* View::createFromXMLFile(std::string path)
 {
+    BXMLDocument* compiled = BXMLDocument::getCompiledFile(path);
+
+    if (compiled)
+        return View::createFromBXML(compiled);
+
     tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
     tinyxml2::XMLError error        = document->LoadFile(path.c_str());
 
@@ -1605,11 +1724,112 @@ View* View::createFromXMLElement(tinyxml2::XMLElement* element)
     return view;
 }
 
+View* View::createFromBXML(BXMLDocument* document)
+{
+    if (!document)
+        fatal("Invalid compiled XML when creating View");
+
+    return View::createFromBXMLElement(document->getRootElement());
+}
+
+View* View::createFromBXMLElement(BXMLElement element)
+{
+    View* view = View::instantiateBXMLElement(element);
+
+    if (!view)
+        return nullptr;
+
+    unsigned index = 0;
+    for (BXMLElement child = element.getFirstChild(); child.isValid(); child = child.getNextSibling())
+        view->handleBXMLChild(child, index++);
+
+    return view;
+}
+
+View* View::instantiateBXMLElement(BXMLElement element)
+{
+    if (!element.isValid())
+        return nullptr;
+
+    // Instantiate the view
+    View* view = nullptr;
+
+    // Special case where element name is brls:View: create from given XML file.
+    // XML attributes are explicitely not passed down to the created view.
+    if (element.getName() == "brls:View")
+    {
+        const BXMLAttribute* xmlAttribute = element.findAttribute("xml");
+
+        if (xmlAttribute)
+            view = View::createFromXMLFile(View::getFilePathXMLAttributeValue(std::string(xmlAttribute->value.raw)));
+        else
+            fatal("brls:View XML tag must have an \"xml\" attribute");
+    }
+    // Otherwise look in the register, once per tag and document
+    else
+    {
+        XMLViewCreator& creator = element.getDocument()->getViewCreators()[element.getNameIndex()];
+
+        if (!creator)
+        {
+            std::string viewName = std::string(element.getName());
+
+            if (!Application::XMLViewsRegisterContains(viewName))
+                fatal("Unknown XML tag \"" + viewName + "\"");
+
+            creator = Application::getXMLViewCreator(viewName);
+        }
+
+        view = creator();
+
+        view->applyBXMLAttributes(element);
+    }
+
+    return view;
+}
+
+void View::handleBXMLChild(BXMLElement child, unsigned index)
+{
+    unsigned max = this->getMaximumAllowedXMLElements();
+
+    if (index >= max)
+        fatal("View \"" + this->describe() + "\" is only allowed to have " + std::to_string(max) + " children XML elements");
+
+    this->handleBXMLElement(child);
+}
+
 void View::handleXMLElement(tinyxml2::XMLElement* element)
 {
     fatal("Raw views cannot have child XML tags");
 }
 
+// Converts the given compiled element and its children back to XML elements of the given document
+static tinyxml2::XMLElement* convertBXMLElement(tinyxml2::XMLDocument* document, BXMLElement element)
+{
+    tinyxml2::XMLElement* xmlElement = document->NewElement(std::string(element.getName()).c_str());
+
+    const BXMLAttribute* attributes = element.getAttributes();
+    for (size_t i = 0; i < element.getAttributesCount(); i++)
+        xmlElement->SetAttribute(attributes[i].name.c_str(), std::string(attributes[i].value.raw).c_str());
+
+    for (BXMLElement child = element.getFirstChild(); child.isValid(); child = child.getNextSibling())
+        xmlElement->InsertEndChild(convertBXMLElement(document, child));
+
+    return xmlElement;
+}
+
+void View::handleBXMLElement(BXMLElement element)
+{
+    // Views that only handle XML elements get the element converted back to XML
+    tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
+    this->bindXMLDocument(document);
+
+    tinyxml2::XMLElement* xmlElement = convertBXMLElement(document, element);
+    document->InsertEndChild(xmlElement);
+
+    this->handleXMLElement(xmlElement);
+}
+
 void View::setMaximumAllowedXMLElements(unsigned max)
 {
     this->maximumAllowedXMLElements = max;
@@ -1918,12 +2138,12 @@ void View::setVisibility(Visibility visibility)
         this->willDisappear();
 }
 
-void View::printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::string name, std::string value)
+void View::printXMLAttributeErrorMessage(std::string tag, std::string name, std::string value)
 {
     if (this->knownAttributes.find(name) != this->knownAttributes.end())
-        fatal("Illegal value \"" + value + "\" for \"" + std::string(element->Name()) + "\" XML attribute \"" + name + "\"");
+        fatal("Illegal value \"" + value + "\" for \"" + tag + "\" XML attribute \"" + name + "\"");
     else
-        fatal("Unknown XML attribute \"" + name + "\" for tag \"" + std::string(element->Name()) + "\" (with value \"" + value + "\")");
+        fatal("Unknown XML attribute \"" + name + "\" for tag \"" + tag + "\" (with value \"" + value + "\")");
 }
 
 void View::registerFloatXMLAttribute(std::string name, FloatAttributeHandler handler)
@@ -1978,7 +2198,32 @@ View* View::getView(std::string id)
     if (id == this->id)
         return this;
 
-    return nullptr;
+    ViewIdIndex* index = this->getRootView()->idIndex;
+
+    if (!index)
+        return nullptr;
+
+    auto it = index->find(id);
+
+    if (it == index->end())
+        return nullptr;
+
+    View* result = nullptr;
+
+    for (View* view : it->second)
+    {
+        if (!view->isInSubtreeOf(this))
+            continue;
+
+        // Multiple children with that ID: fallback to a tree search
+        // to return the first one in depth-first order
+        if (result)
+            return this->searchView(id);
+
+        result = view;
+    }
+
+    return result;
 }
 
 View* View::getNearestView(std::string id)
@@ -2001,7 +2246,11 @@ void View::setId(std::string id)
     if (id == "")
         fatal("ID cannot be empty");
 
+    ViewIdIndex* index = this->getIdIndex();
+
+    unregisterViewId(index, this, this->id);
     this->id = id;
+    registerViewId(index, this, this->id);
 }
 
 bool View::isFocusable()
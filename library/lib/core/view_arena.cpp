@@ -0,0 +1,82 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/view_arena.hpp>
+#include <new>
+
+namespace brls
+{
+
+ViewArena::ViewArena(size_t blockSize)
+    : blockSize(blockSize)
+{
+}
+
+ViewArena::~ViewArena()
+{
+    for (uint8_t* block : this->blocks)
+        ::operator delete(block);
+}
+
+void* ViewArena::allocate(size_t size, size_t alignment)
+{
+    size_t padding = (alignment - (uintptr_t)this->cursor % alignment) % alignment;
+
+    // Start a new block if the current one is full
+    // Oversized allocations get their own block
+    if (!this->cursor || padding + size > this->remaining)
+    {
+        size_t blockSize = size > this->blockSize ? size : this->blockSize;
+        uint8_t* block   = (uint8_t*)::operator new(blockSize);
+
+        this->blocks.push_back(block);
+
+        this->cursor    = block;
+        this->remaining = blockSize;
+        padding         = 0; // operator new is aligned on max_align_t
+    }
+
+    void* ptr = this->cursor + padding;
+
+    this->cursor += padding + size;
+    this->remaining -= padding + size;
+    this->allocatedSize += size;
+
+    return ptr;
+}
+
+size_t ViewArena::getAllocatedSize()
+{
+    return this->allocatedSize;
+}
+
+ViewArena* ViewArena::getCurrent()
+{
+    return ViewArena::current;
+}
+
+ViewArenaScope::ViewArenaScope(ViewArena* arena)
+    : previous(ViewArena::current)
+{
+    ViewArena::current = arena;
+}
+
+ViewArenaScope::~ViewArenaScope()
+{
+    ViewArena::current = this->previous;
+}
+
+} // namespace brls
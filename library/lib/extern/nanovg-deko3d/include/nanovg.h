@@ -142,6 +142,7 @@ enum NVGimageFlags {
     NVG_IMAGE_FLIPY				= 1<<3,		// Flips (inverses) image in Y direction when rendered.
     NVG_IMAGE_PREMULTIPLIED		= 1<<4,		// Image data has premultiplied alpha.
     NVG_IMAGE_NEAREST			= 1<<5,		// Image interpolation is Nearest instead Linear
+    NVG_IMAGE_SDF				= 1<<6,		// Alpha image holds a signed distance field (font atlas in SDF mode)
 };
 
 // Begin drawing a new frame
@@ -160,6 +161,24 @@ void nvgCancelFrame(NVGcontext* ctx);
 // Ends drawing flushing remaining render state.
 void nvgEndFrame(NVGcontext* ctx);
 
+//
+// Parallel tessellation
+//
+// With a dispatcher set, nvgFill() and nvgStroke() only record the current path and render state.
+// All the paths recorded during the frame are then tessellated by nvgEndFrame(), split in at most
+// maxJobs jobs, and submitted to the renderer in their original order: the result is the same as
+// without a dispatcher.
+// The dispatcher must call job(jobPtr, i) for every i in [0, njobs), from any thread and in any order,
+// and only return once all the jobs are done. Jobs do not touch the context state, and nothing else
+// must use the context while the dispatcher runs.
+// Must be called outside of nvgBeginFrame() / nvgEndFrame(). Set a NULL dispatcher to tessellate
+// paths immediately again.
+
+typedef void (*NVGjobFunction)(void* jobPtr, int index);
+typedef void (*NVGdispatchFunction)(void* userPtr, NVGjobFunction job, void* jobPtr, int njobs);
+
+void nvgSetDispatcher(NVGcontext* ctx, NVGdispatchFunction dispatch, void* userPtr, int maxJobs);
+
 //
 // Composite operation
 //
@@ -508,6 +527,56 @@ void nvgFill(NVGcontext* ctx);
 // Fills the current path with current stroke style.
 void nvgStroke(NVGcontext* ctx);
 
+//
+// Geometry
+//
+// A geometry keeps the tessellated vertices of a path so that shapes drawn every frame
+// with the same size (rounded rectangles, shadows, borders...) are flattened and expanded
+// only once. Drawing a geometry only translates its vertices, the paint can change freely.
+//
+// A geometry only stays valid for the scale, rotation and device pixel ratio it was created
+// with: nvgFillGeometry() and nvgStrokeGeometry() draw nothing and return 0 when they changed,
+// the geometry must then be created again.
+
+typedef struct NVGgeometry NVGgeometry;
+
+// Creates a geometry from the current path, expanded for filling.
+// Returns NULL on failure.
+NVGgeometry* nvgCreateFillGeometry(NVGcontext* ctx);
+
+// Creates a geometry from the current path, expanded for stroking with the current
+// stroke width, line cap and line join. Returns NULL on failure.
+NVGgeometry* nvgCreateStrokeGeometry(NVGcontext* ctx);
+
+// Fills a geometry created with nvgCreateFillGeometry() with the current fill style,
+// offset by (x,y). Returns 1 if the geometry was drawn.
+int nvgFillGeometry(NVGcontext* ctx, NVGgeometry* geometry, float x, float y);
+
+// Strokes a geometry created with nvgCreateStrokeGeometry() with the current stroke paint,
+// offset by (x,y). Returns 1 if the geometry was drawn.
+int nvgStrokeGeometry(NVGcontext* ctx, NVGgeometry* geometry, float x, float y);
+
+// Deletes a geometry.
+void nvgDeleteGeometry(NVGgeometry* geometry);
+
+//
+// Shapes
+//
+// Rounded rectangles can be drawn as a single quad, their coverage being computed in the fragment
+// shader from the distance to the outline instead of tessellating them. The current path is cleared.
+// Only color and gradient paints are supported, image paints and render back-ends without support
+// fall back to tessellation.
+
+// Fills a rounded rectangle with the current fill paint.
+void nvgFillRoundedRect(NVGcontext* ctx, float x, float y, float w, float h, float r);
+
+// Strokes the outline of a rounded rectangle with the current stroke paint and stroke width.
+void nvgStrokeRoundedRect(NVGcontext* ctx, float x, float y, float w, float h, float r);
+
+// Fills the part of the rectangle (sx,sy,sw,sh) outside of a rounded rectangle with the
+// current fill paint. Used with a box gradient to draw the shadow of a rounded rectangle.
+void nvgFillRoundedRectShadow(NVGcontext* ctx, float x, float y, float w, float h, float r, float sx, float sy, float sw, float sh);
+
 
 //
 // Text
@@ -580,6 +649,15 @@ void nvgFontBlur(NVGcontext* ctx, float blur);
 // Sets the letter spacing of current text style.
 void nvgTextLetterSpacing(NVGcontext* ctx, float spacing);
 
+// Enables or disables signed distance field text rendering. In this mode, glyphs are rasterized
+// once as distance fields and scaled to every font size, so changing the font size or
+// the scale doesn't rasterize glyphs again. Font blur is ignored.
+// Clears the font atlas, must be called outside of nvgBeginFrame() / nvgEndFrame().
+void nvgTextSDF(NVGcontext* ctx, int enabled);
+
+// Returns 1 if signed distance field text rendering is enabled.
+int nvgTextIsSDF(NVGcontext* ctx);
+
 // Sets the proportional line height of current text style. The line height is specified as multiple of font size.
 void nvgTextLineHeight(NVGcontext* ctx, float lineHeight);
 
@@ -619,6 +697,33 @@ int nvgTextGlyphPositions(NVGcontext* ctx, float x, float y, const char* string,
 // Measured values are returned in local coordinate space.
 void nvgTextMetrics(NVGcontext* ctx, float* ascender, float* descender, float* lineh);
 
+// Rasterizes the glyphs of the given text with the current font settings, without drawing anything.
+// Used to avoid rasterizing glyphs the first time a text is drawn.
+// Returns 0 if the font atlas is full.
+int nvgTextPrewarm(NVGcontext* ctx, const char* string, const char* end);
+
+// Glyph cache: rasterized glyphs can be exported and imported back later (see fontstash)
+typedef struct NVGcachedGlyph {
+	unsigned int codepoint;
+	int index;
+	short size, blur;
+	short width, height; // bitmap size, padding included
+	short xadv, xoff, yoff;
+} NVGcachedGlyph;
+
+// Returns the number of glyphs of the given font.
+int nvgFontGlyphCount(NVGcontext* ctx, int font);
+
+// Gets the rasterized glyph at the given index. Bitmap can be NULL to only get the metrics.
+// Returns 0 if the glyph is not rasterized or if the bitmap is too small.
+int nvgExportFontGlyph(NVGcontext* ctx, int font, int index, NVGcachedGlyph* glyph, unsigned char* bitmap, int bitmapSize);
+
+// Adds a previously exported glyph to the font atlas. Returns 0 if the atlas is full.
+int nvgImportFontGlyph(NVGcontext* ctx, int font, const NVGcachedGlyph* glyph, const unsigned char* bitmap);
+
+// Returns the data of the given font.
+const unsigned char* nvgFontData(NVGcontext* ctx, int font, int* size);
+
 // Breaks the specified text into lines. If end is specified only the sub-string will be used.
 // White space is stripped at the beginning of the rows, the text is split at word boundaries or when new-line characters are encountered.
 // Words longer than the max width are slit at nearest character (i.e. no hyphenation).
@@ -638,11 +743,32 @@ struct NVGscissor {
 };
 typedef struct NVGscissor NVGscissor;
 
+// Gets and sets the whole scissor state, so that a scissor can be restored without nvgSave() and nvgRestore().
+void nvgCurrentScissor(NVGcontext* ctx, NVGscissor* scissor);
+void nvgRestoreScissor(NVGcontext* ctx, const NVGscissor* scissor);
+
 struct NVGvertex {
     float x,y,u,v;
 };
 typedef struct NVGvertex NVGvertex;
 
+enum NVGshapeType {
+    NVG_SHAPE_FILL,        // inside of the rounded rectangle
+    NVG_SHAPE_STROKE,    // outline of the rounded rectangle, strokeWidth wide
+    NVG_SHAPE_OUTSIDE,    // outside of the rounded rectangle
+};
+
+// Rounded rectangle drawn by renderShape
+struct NVGshape {
+    float xform[6];    // from the shape space, centered on the rectangle, to the screen
+    float extent[2];
+    float radius;
+    float strokeWidth;
+    float antialias;    // width of the antialiased edge, in the shape space
+    int type;
+};
+typedef struct NVGshape NVGshape;
+
 struct NVGpath {
     int first;
     int count;
@@ -671,6 +797,7 @@ struct NVGparams {
     void (*renderFill)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths);
     void (*renderStroke)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, float strokeWidth, const NVGpath* paths, int npaths);
     void (*renderTriangles)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts, float fringe);
+    void (*renderShape)(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGshape* shape, const NVGvertex* verts, int nverts); // optional
     void (*renderDelete)(void* uptr);
 };
 typedef struct NVGparams NVGparams;
@@ -681,6 +808,26 @@ void nvgDeleteInternal(NVGcontext* ctx);
 
 NVGparams* nvgInternalParams(NVGcontext* ctx);
 
+// Returns the font atlas image that text glyphs are currently rendered to (NVG_TEXTURE_ALPHA).
+int nvgInternalFontImage(NVGcontext* ctx);
+
+// Pipelined rendering
+//
+// nvgEndFrameDeferred() ends the frame without submitting it: the render calls recorded during the
+// frame are moved to the given frame, to be submitted later with nvgSubmitFrame(), for instance by a
+// render thread while the next frame is drawn. Requires a dispatcher, see nvgSetDispatcher().
+// nvgSubmitFrame() tessellates the paths of the frame, calls the given renderer with the viewport and
+// render calls of the frame, then flushes it. It only uses the jobs and the dispatcher of the context.
+// While frames are submitted from another thread, the texture callbacks of the context must be forwarded
+// to that thread, in order with the frames: font atlases replaced during a frame are deleted by the next
+// nvgBeginFrame(), so the frame must be queued for submission before that.
+typedef struct NVGframe NVGframe;
+
+NVGframe* nvgCreateFrame(void);
+void nvgDeleteFrame(NVGframe* frame);
+void nvgEndFrameDeferred(NVGcontext* ctx, NVGframe* frame);
+void nvgSubmitFrame(NVGcontext* ctx, NVGframe* frame, const NVGparams* params);
+
 // Debug function to dump cached path data.
 void nvgDebugDumpPathCache(NVGcontext* ctx);
 
@@ -34,7 +34,8 @@ enum VKNVGshaderType {
   NSVG_SHADER_FILLGRAD,
   NSVG_SHADER_FILLIMG,
   NSVG_SHADER_SIMPLE,
-  NSVG_SHADER_IMG
+  NSVG_SHADER_IMG,
+  NSVG_SHADER_SHAPE
 };
 
 struct DKNVGtextureDescriptor {
@@ -67,6 +68,9 @@ struct DKNVGcall {
     int triangleCount;
     int uniformOffset;
     DKNVGblend blendFunc;
+    int batchCount; // Number of calls drawn with this one, set on the first call of the batch.
+    int indexOffset; // Indices of the batched convex fills.
+    int indexCount;
 };
 
 struct DKNVGpath {
@@ -90,6 +94,10 @@ struct DKNVGfragUniforms {
     float strokeThr;
     int texType;
     int type;
+    float shapeMat[12];
+    float shape[4]; // extent, radius, antialiasing width
+    float shapeStroke;
+    int shapeType;
 };
 
 namespace nvg {
@@ -150,7 +158,11 @@ namespace nvg {
             };
         private:
             static constexpr size_t DynamicCmdSize = 0x20000;
-            static constexpr size_t FragmentUniformSize = sizeof(DKNVGfragUniforms) + 4 - sizeof(DKNVGfragUniforms) % 4;
+            /* Stride of the paints array of the fragment uniform block (std140), paints are stored with it so a batch can be pushed at once. */
+            static constexpr size_t FragmentUniformSize = 0x100;
+            static_assert(sizeof(DKNVGfragUniforms) <= FragmentUniformSize);
+            /* Maximum number of calls drawn at once, must match PAINT_COUNT in the shaders. */
+            static constexpr int MaxBatchSize = 16;
             static constexpr size_t MaxImages = 0x1000;
 
             /* From the application. */
@@ -166,6 +178,10 @@ namespace nvg {
             dk::UniqueCmdBuf m_dyn_cmd_buf;
             CCmdMemRing<1> m_dyn_cmd_mem;
             std::optional<CMemPool::Handle> m_vertex_buffer;
+            std::optional<CMemPool::Handle> m_paint_buffer;
+            std::optional<CMemPool::Handle> m_index_buffer;
+            std::vector<float> m_paints;
+            std::vector<u32> m_indices;
             CShader m_vertex_shader;
             CShader m_fragment_shader;
             CMemPool::Handle m_view_uniform_buffer;
@@ -180,15 +196,20 @@ namespace nvg {
 
             int AcquireImageDescriptor(std::shared_ptr<Texture> texture, int image);
             void FreeImageDescriptor(int image);
-            void SetUniforms(const DKNVGcontext &ctx, int offset, int image);
+            void SetUniforms(const DKNVGcontext &ctx, int offset, int image, int count = 1);
 
-            void UpdateVertexBuffer(const void *data, size_t size);
+            void UpdateBuffer(std::optional<CMemPool::Handle> &buffer, const void *data, size_t size);
 
             void DrawFill(const DKNVGcontext &ctx, const DKNVGcall &call);
             void DrawConvexFill(const DKNVGcontext &ctx, const DKNVGcall &call);
             void DrawStroke(const DKNVGcontext &ctx, const DKNVGcall &call);
             void DrawTriangles(const DKNVGcontext &ctx, const DKNVGcall &call);
 
+            bool CanBatch(const DKNVGcontext &ctx, const DKNVGcall &a, const DKNVGcall &b);
+            int GetBatchSize(const DKNVGcontext &ctx, int first);
+            void PrepareConvexFillBatch(const DKNVGcontext &ctx, DKNVGcall &call);
+            void PrepareBatches(DKNVGcontext &ctx);
+
             std::shared_ptr<Texture> FindTexture(int id);
         public:
             DkRenderer(unsigned int view_width, unsigned int view_height, dk::Device device, dk::Queue queue, CMemPool &image_mem_pool, CMemPool &code_mem_pool, CMemPool &data_mem_pool);
@@ -118,7 +118,9 @@ static int dknvg__convertPaint(DKNVGcontext* dk, DKNVGfragUniforms* frag, NVGpai
         if (tex->type == NVG_TEXTURE_RGBA)
             frag->texType = (tex->flags & NVG_IMAGE_PREMULTIPLIED) ? 0 : 1;
         else
-            frag->texType = 2;
+            frag->texType = (tex->flags & NVG_IMAGE_SDF) ? 3 : 2;
+        // Smoothing width of distance field images
+        frag->feather = paint->feather;
 //		printf("frag->texType = %d\n", frag->texType);
     } else {
         frag->type = NSVG_SHADER_FILLGRAD;
@@ -461,6 +463,50 @@ error:
     if (dk->ncalls > 0) dk->ncalls--;
 }
 
+static void dknvg__renderShape(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+                               const NVGshape* shape, const NVGvertex* verts, int nverts)
+{
+    DKNVGcontext* dk = (DKNVGcontext*)uptr;
+    DKNVGcall* call = dknvg__allocCall(dk);
+    DKNVGfragUniforms* frag;
+    float invxform[6];
+
+    if (call == NULL) return;
+
+    call->type = DKNVG_TRIANGLES;
+    call->image = 0;
+    call->blendFunc = dknvg__blendCompositeOperation(compositeOperation);
+
+    call->triangleOffset = dknvg__allocVerts(dk, nverts);
+    if (call->triangleOffset == -1) goto error;
+    call->triangleCount = nverts;
+
+    memcpy(&dk->verts[call->triangleOffset], verts, sizeof(NVGvertex) * nverts);
+
+    // Paint as a gradient, covered by the shape
+    call->uniformOffset = dknvg__allocFragUniforms(dk, 1);
+    if (call->uniformOffset == -1) goto error;
+    frag = nvg__fragUniformPtr(dk, call->uniformOffset);
+    dknvg__convertPaint(dk, frag, paint, scissor, 1.0f, 1.0f, -1.0f);
+    frag->type = NSVG_SHADER_SHAPE;
+
+    nvgTransformInverse(invxform, shape->xform);
+    dknvg__xformToMat3x4(frag->shapeMat, invxform);
+    frag->shape[0] = shape->extent[0];
+    frag->shape[1] = shape->extent[1];
+    frag->shape[2] = shape->radius;
+    frag->shape[3] = shape->antialias;
+    frag->shapeStroke = shape->strokeWidth;
+    frag->shapeType = shape->type;
+
+    return;
+
+error:
+    // We get here if call alloc was ok, but something else is not.
+    // Roll back the last call to prevent drawing it.
+    if (dk->ncalls > 0) dk->ncalls--;
+}
+
 static void dknvg__renderDelete(void* uptr) {
     DKNVGcontext* dk = (DKNVGcontext*)uptr;
     if (dk == NULL) return;
@@ -492,6 +538,7 @@ NVGcontext* nvgCreateDk(nvg::DkRenderer *renderer, int flags) {
     params.renderFill = dknvg__renderFill;
     params.renderStroke = dknvg__renderStroke;
     params.renderTriangles = dknvg__renderTriangles;
+    params.renderShape = dknvg__renderShape;
     params.renderDelete = dknvg__renderDelete;
     params.userPtr = dk;
     params.edgeAntiAlias = flags & NVG_ANTIALIAS ? 1 : 0;
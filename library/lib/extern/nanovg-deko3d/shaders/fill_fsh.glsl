@@ -2,7 +2,10 @@
 
 layout(binding = 0) uniform sampler2D tex;
 
-layout(std140, binding = 0) uniform frag {
+// Must match DkRenderer::MaxBatchSize.
+#define PAINT_COUNT 16
+
+struct Paint {
     mat3 scissorMat;
     mat3 paintMat;
     vec4 innerCol;
@@ -16,12 +19,40 @@ layout(std140, binding = 0) uniform frag {
     float strokeThr;
     int texType;
     int type;
+    mat3 shapeMat;
+    vec4 shape;
+    float shapeStroke;
+    int shapeType;
+};
+
+// Paints of the calls of a batch, indexed per vertex.
+layout(std140, binding = 0) uniform frag {
+    Paint paints[PAINT_COUNT];
 };
 
 layout(location = 0) in vec2 ftcoord;
 layout(location = 1) in vec2 fpos;
+layout(location = 2) flat in int fpaint;
 layout(location = 0) out vec4 outColor;
 
+#define scissorMat paints[fpaint].scissorMat
+#define paintMat paints[fpaint].paintMat
+#define innerCol paints[fpaint].innerCol
+#define outerCol paints[fpaint].outerCol
+#define scissorExt paints[fpaint].scissorExt
+#define scissorScale paints[fpaint].scissorScale
+#define extent paints[fpaint].extent
+#define radius paints[fpaint].radius
+#define feather paints[fpaint].feather
+#define strokeMult paints[fpaint].strokeMult
+#define strokeThr paints[fpaint].strokeThr
+#define texType paints[fpaint].texType
+#define type paints[fpaint].type
+#define shapeMat paints[fpaint].shapeMat
+#define shape paints[fpaint].shape
+#define shapeStroke paints[fpaint].shapeStroke
+#define shapeType paints[fpaint].shapeType
+
 float sdroundrect(vec2 pt, vec2 ext, float rad) {
     vec2 ext2 = ext - vec2(rad,rad);
     vec2 d = abs(pt) - ext2;
@@ -55,6 +86,7 @@ void main(void) {
 
         if (texType == 1) color = vec4(color.xyz*color.w,color.w);
         if (texType == 2) color = vec4(color.x);
+        if (texType == 3) color = vec4(clamp((color.x - 0.5) / feather + 0.5, 0.0, 1.0));
         // Apply color tint and alpha.
         color *= innerCol;
         // Combine alpha
@@ -68,8 +100,23 @@ void main(void) {
 
         if (texType == 1) color = vec4(color.xyz*color.w,color.w);
         if (texType == 2) color = vec4(color.x);
+        if (texType == 3) color = vec4(clamp((color.x - 0.5) / feather + 0.5, 0.0, 1.0));
         color *= scissor;
         result = color * innerCol;
+    } else if (type == 4) {		// Rounded rectangle shape
+        // Coverage from the distance to the outline
+        vec2 spt = (shapeMat * vec3(fpos,1.0)).xy;
+        float sd = sdroundrect(spt, shape.xy, shape.z);
+        if (shapeType == 1) sd = abs(sd) - shapeStroke*0.5;
+        if (shapeType == 2) sd = -sd;
+        float coverage = clamp(0.5 - sd / shape.w, 0.0, 1.0);
+        // Calculate gradient color using box gradient
+        vec2 pt = (paintMat * vec3(fpos,1.0)).xy;
+        float d = clamp((sdroundrect(pt, extent, radius) + feather*0.5) / feather, 0.0, 1.0);
+        vec4 color = mix(innerCol,outerCol,d);
+        // Combine alpha
+        color *= coverage * scissor;
+        result = color;
     }
 
     outColor = result;
@@ -2,8 +2,10 @@
 
 layout (location = 0) in vec2 vertex;
 layout (location = 1) in vec2 tcoord;
+layout (location = 2) in float paint;
 layout (location = 0) out vec2 ftcoord;
 layout (location = 1) out vec2 fpos;
+layout (location = 2) flat out int fpaint;
 
 layout (std140, binding = 0) uniform View
 {
@@ -13,5 +15,6 @@ layout (std140, binding = 0) uniform View
 void main(void) {
     ftcoord = tcoord;
     fpos = vertex;
+    fpaint = int(paint);
     gl_Position = vec4(2.0*vertex.x/view.size.x - 1.0, 1.0 - 2.0*vertex.y/view.size.y, 0, 1);
 };
\ No newline at end of file
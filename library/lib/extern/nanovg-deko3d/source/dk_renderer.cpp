@@ -1,5 +1,6 @@
 #include <nanovg/dk_renderer.hpp>
 
+#include <algorithm>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -15,11 +16,13 @@ namespace nvg {
 
     namespace {
 
-        constexpr std::array VertexBufferState = { DkVtxBufferState{sizeof(NVGvertex), 0}, };
+        /* The paint index of each vertex in its batch lives in a separate buffer, NVGvertex is left untouched. */
+        constexpr std::array VertexBufferState = { DkVtxBufferState{sizeof(NVGvertex), 0}, DkVtxBufferState{sizeof(float), 0}, };
 
         constexpr std::array VertexAttribState = {
             DkVtxAttribState{0, 0, offsetof(NVGvertex, x), DkVtxAttribSize_2x32, DkVtxAttribType_Float, 0},
             DkVtxAttribState{0, 0, offsetof(NVGvertex, u), DkVtxAttribSize_2x32, DkVtxAttribType_Float, 0},
+            DkVtxAttribState{1, 0, 0, DkVtxAttribSize_1x32, DkVtxAttribType_Float, 0},
         };
 
         struct View {
@@ -116,7 +119,7 @@ namespace nvg {
         m_sampler_descriptor_set.allocate(m_data_mem_pool);
 
         m_view_uniform_buffer = m_data_mem_pool.allocate(sizeof(View), DK_UNIFORM_BUF_ALIGNMENT);
-        m_frag_uniform_buffer = m_data_mem_pool.allocate(sizeof(FragmentUniformSize), DK_UNIFORM_BUF_ALIGNMENT);
+        m_frag_uniform_buffer = m_data_mem_pool.allocate(FragmentUniformSize * MaxBatchSize, DK_UNIFORM_BUF_ALIGNMENT);
 
         /* Create and bind preset samplers. */
         dk::UniqueCmdBuf init_cmd_buf = dk::CmdBufMaker{m_device}.create();
@@ -155,6 +158,14 @@ namespace nvg {
             m_vertex_buffer->destroy();
         }
 
+        if (m_paint_buffer) {
+            m_paint_buffer->destroy();
+        }
+
+        if (m_index_buffer) {
+            m_index_buffer->destroy();
+        }
+
         m_view_uniform_buffer.destroy();
         m_frag_uniform_buffer.destroy();
         m_textures.clear();
@@ -203,26 +214,27 @@ namespace nvg {
         }
     }
 
-    void DkRenderer::UpdateVertexBuffer(const void *data, size_t size) {
-        /* Destroy the existing vertex buffer if it is too small. */
-        if (m_vertex_buffer && m_vertex_buffer->getSize() < size) {
-            m_vertex_buffer->destroy();
-            m_vertex_buffer.reset();
+    void DkRenderer::UpdateBuffer(std::optional<CMemPool::Handle> &buffer, const void *data, size_t size) {
+        /* Destroy the existing buffer if it is too small. */
+        if (buffer && buffer->getSize() < size) {
+            buffer->destroy();
+            buffer.reset();
         }
 
         /* Create a new buffer if needed. */
-        if (!m_vertex_buffer) {
-            m_vertex_buffer = m_data_mem_pool.allocate(size);
+        if (!buffer) {
+            buffer = m_data_mem_pool.allocate(size);
         }
 
-        /* Copy data to the vertex buffer if it exists. */
-        if (m_vertex_buffer) {
-            memcpy(m_vertex_buffer->getCpuAddr(), data, size);
+        /* Copy data to the buffer if it exists. */
+        if (buffer) {
+            memcpy(buffer->getCpuAddr(), data, size);
         }
     }
 
-    void DkRenderer::SetUniforms(const DKNVGcontext &ctx, int offset, int image) {
-        m_dyn_cmd_buf.pushConstants(m_frag_uniform_buffer.getGpuAddr(), m_frag_uniform_buffer.getSize(), 0, ctx.fragSize, ctx.uniforms + offset);
+    void DkRenderer::SetUniforms(const DKNVGcontext &ctx, int offset, int image, int count) {
+        /* Paints of a batch are consecutive, they are pushed at once. */
+        m_dyn_cmd_buf.pushConstants(m_frag_uniform_buffer.getGpuAddr(), m_frag_uniform_buffer.getSize(), 0, ctx.fragSize * count, ctx.uniforms + offset);
         m_dyn_cmd_buf.bindUniformBuffer(DkStage_Fragment, 0, m_frag_uniform_buffer.getGpuAddr(), m_frag_uniform_buffer.getSize());
 
         /* Attempt to find a texture. */
@@ -323,6 +335,13 @@ namespace nvg {
         DKNVGpath *paths = &ctx.paths[call.pathOffset];
         int npaths = call.pathCount;
 
+        /* Batched convex fills are drawn as indexed triangles, fans and fringes in drawing order. */
+        if (call.batchCount > 1) {
+            this->SetUniforms(ctx, call.uniformOffset, call.image, call.batchCount);
+            m_dyn_cmd_buf.drawIndexed(DkPrimitive_Triangles, call.indexCount, 1, call.indexOffset, 0, 0);
+            return;
+        }
+
         this->SetUniforms(ctx, call.uniformOffset, call.image);
 
         for (int i = 0; i < npaths; i++) {
@@ -395,8 +414,104 @@ namespace nvg {
     }
 
     void DkRenderer::DrawTriangles(const DKNVGcontext &ctx, const DKNVGcall &call) {
-        this->SetUniforms(ctx, call.uniformOffset, call.image);
-        m_dyn_cmd_buf.draw(DkPrimitive_Triangles, call.triangleCount, 1, call.triangleOffset, 0);
+        /* Vertices of batched calls are contiguous. */
+        const DKNVGcall &last = (&call)[call.batchCount - 1];
+        int count = last.triangleOffset + last.triangleCount - call.triangleOffset;
+
+        this->SetUniforms(ctx, call.uniformOffset, call.image, call.batchCount);
+        m_dyn_cmd_buf.draw(DkPrimitive_Triangles, count, 1, call.triangleOffset, 0);
+    }
+
+    bool DkRenderer::CanBatch(const DKNVGcontext &ctx, const DKNVGcall &a, const DKNVGcall &b) {
+        /* Only calls without stencil passes can be merged. */
+        if (a.type != b.type || a.image != b.image) {
+            return false;
+        }
+
+        if (a.type == DKNVG_TRIANGLES) {
+            if (b.triangleOffset != a.triangleOffset + a.triangleCount) {
+                return false;
+            }
+        } else if (a.type != DKNVG_CONVEXFILL) {
+            return false;
+        }
+
+        /* The paints of a batch are pushed as one array. */
+        if (b.uniformOffset != a.uniformOffset + ctx.fragSize) {
+            return false;
+        }
+
+        /* Same blending and scissor, the paints are indexed per vertex. */
+        if (memcmp(&a.blendFunc, &b.blendFunc, sizeof(DKNVGblend)) != 0) {
+            return false;
+        }
+
+        const auto *frag_a = reinterpret_cast<const DKNVGfragUniforms *>(ctx.uniforms + a.uniformOffset);
+        const auto *frag_b = reinterpret_cast<const DKNVGfragUniforms *>(ctx.uniforms + b.uniformOffset);
+        return memcmp(frag_a->scissorMat, frag_b->scissorMat, sizeof(frag_a->scissorMat)) == 0 &&
+               memcmp(frag_a->scissorExt, frag_b->scissorExt, sizeof(frag_a->scissorExt)) == 0 &&
+               memcmp(frag_a->scissorScale, frag_b->scissorScale, sizeof(frag_a->scissorScale)) == 0;
+    }
+
+    int DkRenderer::GetBatchSize(const DKNVGcontext &ctx, int first) {
+        int i = first + 1;
+
+        while (i < ctx.ncalls && i - first < MaxBatchSize && this->CanBatch(ctx, ctx.calls[i - 1], ctx.calls[i])) {
+            i++;
+        }
+
+        return i - first;
+    }
+
+    void DkRenderer::PrepareConvexFillBatch(const DKNVGcontext &ctx, DKNVGcall &call) {
+        call.indexOffset = m_indices.size();
+
+        for (int i = 0; i < call.batchCount; i++) {
+            const DKNVGcall &batched = (&call)[i];
+
+            for (int j = 0; j < batched.pathCount; j++) {
+                const DKNVGpath &path = ctx.paths[batched.pathOffset + j];
+
+                /* Fan. */
+                std::fill_n(m_paints.begin() + path.fillOffset, path.fillCount, static_cast<float>(i));
+                for (int k = 0; k < path.fillCount - 2; k++) {
+                    m_indices.insert(m_indices.end(), { static_cast<u32>(path.fillOffset), static_cast<u32>(path.fillOffset + k + 1), static_cast<u32>(path.fillOffset + k + 2) });
+                }
+
+                /* Fringes, every other triangle of the strip is flipped to keep its winding. */
+                std::fill_n(m_paints.begin() + path.strokeOffset, path.strokeCount, static_cast<float>(i));
+                for (int k = 0; k < path.strokeCount - 2; k++) {
+                    const u32 first = path.strokeOffset + k;
+                    m_indices.insert(m_indices.end(), { first + (k & 1), first + 1 - (k & 1), first + 2 });
+                }
+            }
+        }
+
+        call.indexCount = m_indices.size() - call.indexOffset;
+    }
+
+    void DkRenderer::PrepareBatches(DKNVGcontext &ctx) {
+        /* Vertices outside of batches use the first paint. */
+        m_paints.assign(ctx.nverts, 0.0f);
+        m_indices.clear();
+
+        for (int i = 0; i < ctx.ncalls; i += ctx.calls[i].batchCount) {
+            DKNVGcall &call = ctx.calls[i];
+            call.batchCount = this->GetBatchSize(ctx, i);
+
+            if (call.batchCount == 1) {
+                continue;
+            }
+
+            if (call.type == DKNVG_TRIANGLES) {
+                for (int j = 0; j < call.batchCount; j++) {
+                    const DKNVGcall &batched = ctx.calls[i + j];
+                    std::fill_n(m_paints.begin() + batched.triangleOffset, batched.triangleCount, static_cast<float>(j));
+                }
+            } else {
+                this->PrepareConvexFillBatch(ctx, call);
+            }
+        }
     }
 
     int DkRenderer::Create(DKNVGcontext &ctx) {
@@ -505,8 +620,15 @@ namespace nvg {
             /* Prepare dynamic command buffer. */
             m_dyn_cmd_mem.begin(m_dyn_cmd_buf);
 
+            /* Merge consecutive calls drawn with the same state. */
+            this->PrepareBatches(ctx);
+
             /* Update buffers with data. */
-            this->UpdateVertexBuffer(ctx.verts, ctx.nverts * sizeof(NVGvertex));
+            this->UpdateBuffer(m_vertex_buffer, ctx.verts, ctx.nverts * sizeof(NVGvertex));
+            this->UpdateBuffer(m_paint_buffer, m_paints.data(), m_paints.size() * sizeof(float));
+            if (!m_indices.empty()) {
+                this->UpdateBuffer(m_index_buffer, m_indices.data(), m_indices.size() * sizeof(u32));
+            }
 
             /* Enable blending. */
             m_dyn_cmd_buf.bindColorState(dk::ColorState{}.setBlendEnable(0, true));
@@ -516,6 +638,10 @@ namespace nvg {
             m_dyn_cmd_buf.bindVtxAttribState(VertexAttribState);
             m_dyn_cmd_buf.bindVtxBufferState(VertexBufferState);
             m_dyn_cmd_buf.bindVtxBuffer(0, m_vertex_buffer->getGpuAddr(), m_vertex_buffer->getSize());
+            m_dyn_cmd_buf.bindVtxBuffer(1, m_paint_buffer->getGpuAddr(), m_paint_buffer->getSize());
+            if (!m_indices.empty()) {
+                m_dyn_cmd_buf.bindIdxBuffer(DkIdxFormat_Uint32, m_index_buffer->getGpuAddr());
+            }
 
             /* Push the view size to the uniform buffer and bind it. */
             const auto view = View{glm::vec2{m_view_width, m_view_height}};
@@ -523,7 +649,7 @@ namespace nvg {
             m_dyn_cmd_buf.bindUniformBuffer(DkStage_Vertex, 0, m_view_uniform_buffer.getGpuAddr(), m_view_uniform_buffer.getSize());
 
             /* Iterate over calls. */
-            for (int i = 0; i < ctx.ncalls; i++) {
+            for (int i = 0; i < ctx.ncalls; i += ctx.calls[i].batchCount) {
                 const DKNVGcall &call = ctx.calls[i];
 
                 /* Perform blending. */
@@ -44,6 +44,9 @@
 #define NVG_INIT_VERTS_SIZE 256
 #define NVG_MAX_STATES 32
 
+// Minimum number of paths tessellated by a job, so that small frames are not dispatched
+#define NVG_MIN_JOB_PATHS 32
+
 #define NVG_KAPPA90 0.5522847493f	// Length proportional to radius of a cubic bezier handle for 90deg arcs.
 
 #define NVG_COUNTOF(arr) (sizeof(arr) / sizeof(0[arr]))
@@ -109,6 +112,68 @@ struct NVGpathCache {
 };
 typedef struct NVGpathCache NVGpathCache;
 
+// Paths and vertices copied out of a path cache until the end of the frame
+struct NVGpathBuffer {
+	NVGpath* paths;
+	int* offsets;	// fill and stroke vertex offsets of every path, see nvg__resolvePathBuffer()
+	int npaths;
+	int cpaths;
+	NVGvertex* verts;
+	int nverts;
+	int cverts;
+};
+typedef struct NVGpathBuffer NVGpathBuffer;
+
+enum NVGdeferredType {
+	NVG_DEFERRED_FILL,			// path commands, tessellated by a job
+	NVG_DEFERRED_STROKE,
+	NVG_DEFERRED_PATHS_FILL,	// already tessellated paths
+	NVG_DEFERRED_PATHS_STROKE,
+	NVG_DEFERRED_TRIANGLES,
+	NVG_DEFERRED_SHAPE,
+};
+
+// Render call recorded while a dispatcher is set
+struct NVGdeferredCall {
+	int type;
+	NVGpaint paint;
+	NVGcompositeOperationState compositeOperation;
+	NVGscissor scissor;
+	float fringe;
+	float strokeWidth;
+	int antialias;
+	int lineCap;
+	int lineJoin;
+	float miterLimit;
+	int command0, ncommands;	// path commands of FILL and STROKE calls
+	int job;					// job tessellating FILL and STROKE calls
+	int path0, npaths;			// paths, in the job output for FILL and STROKE calls
+	int vert0, nverts;			// vertices of TRIANGLES and SHAPE calls
+	float bounds[4];
+	NVGshape shape;
+};
+typedef struct NVGdeferredCall NVGdeferredCall;
+
+struct NVGtessJob {
+	NVGcontext* ctx;	// holds the path cache of the job
+	NVGpathBuffer output;
+	int first, last;	// range of deferred calls
+};
+typedef struct NVGtessJob NVGtessJob;
+
+// Render calls recorded during a frame
+struct NVGframe {
+	NVGdeferredCall* calls;
+	int ncalls;
+	int ccalls;
+	float* commands;	// path commands of FILL and STROKE calls
+	int ncommands;
+	int ccommands;
+	NVGpathBuffer buffer;	// paths and vertices of the other calls
+	float width, height, devicePxRatio;
+	float tessTol, distTol;
+};
+
 struct NVGcontext {
 	NVGparams params;
 	float* commands;
@@ -125,10 +190,20 @@ struct NVGcontext {
 	struct FONScontext* fs;
 	int fontImages[NVG_MAX_FONTIMAGES];
 	int fontImageIdx;
+	int fontImageFlags;
 	int drawCallCount;
 	int fillTriCount;
 	int strokeTriCount;
 	int textTriCount;
+	NVGdispatchFunction dispatch;
+	void* dispatchPtr;
+	int maxJobs;
+	NVGframe frame;
+	int pathCommands;	// offset of the current path in frame.commands, -1 until it's recorded
+	int pathNCommands;
+	int compactFontImages;
+	NVGtessJob* jobs;
+	int cjobs;
 };
 
 static float nvg__sqrtf(float a) { return sqrtf(a); }
@@ -197,6 +272,142 @@ error:
 	return NULL;
 }
 
+static void nvg__clearPathBuffer(NVGpathBuffer* b)
+{
+	b->npaths = 0;
+	b->nverts = 0;
+}
+
+static void nvg__deletePathBuffer(NVGpathBuffer* b)
+{
+	if (b->paths != NULL) free(b->paths);
+	if (b->offsets != NULL) free(b->offsets);
+	if (b->verts != NULL) free(b->verts);
+	memset(b, 0, sizeof(NVGpathBuffer));
+}
+
+// Returns the offset of the copied vertices, or -1 if out of memory
+static int nvg__appendVerts(NVGpathBuffer* b, const NVGvertex* verts, int nverts)
+{
+	int offset = b->nverts;
+
+	if (b->nverts+nverts > b->cverts) {
+		NVGvertex* v;
+		int cverts = b->nverts+nverts + b->cverts/2;
+		v = (NVGvertex*)realloc(b->verts, sizeof(NVGvertex)*cverts);
+		if (v == NULL) return -1;
+		b->verts = v;
+		b->cverts = cverts;
+	}
+
+	if (nverts > 0)
+		memcpy(&b->verts[b->nverts], verts, sizeof(NVGvertex)*nverts);
+	b->nverts += nverts;
+
+	return offset;
+}
+
+// Returns the index of the first copied path, or -1 if out of memory
+static int nvg__appendPaths(NVGpathBuffer* b, const NVGpath* paths, int npaths)
+{
+	int i, first = b->npaths;
+
+	if (b->npaths+npaths > b->cpaths) {
+		NVGpath* p;
+		int* o;
+		int cpaths = b->npaths+npaths + b->cpaths/2;
+		p = (NVGpath*)realloc(b->paths, sizeof(NVGpath)*cpaths);
+		if (p == NULL) return -1;
+		b->paths = p;
+		o = (int*)realloc(b->offsets, sizeof(int)*2*cpaths);
+		if (o == NULL) return -1;
+		b->offsets = o;
+		b->cpaths = cpaths;
+	}
+
+	// Vertices are stored as offsets until the buffer stops growing
+	for (i = 0; i < npaths; i++) {
+		int fill = nvg__appendVerts(b, paths[i].fill, paths[i].nfill);
+		int stroke = nvg__appendVerts(b, paths[i].stroke, paths[i].nstroke);
+		if (fill < 0 || stroke < 0) return -1;
+		b->paths[b->npaths] = paths[i];
+		b->offsets[b->npaths*2+0] = fill;
+		b->offsets[b->npaths*2+1] = stroke;
+		b->npaths++;
+	}
+
+	return first;
+}
+
+static void nvg__resolvePathBuffer(NVGpathBuffer* b)
+{
+	int i;
+	for (i = 0; i < b->npaths; i++) {
+		b->paths[i].fill = b->verts != NULL ? &b->verts[b->offsets[i*2+0]] : NULL;
+		b->paths[i].stroke = b->verts != NULL ? &b->verts[b->offsets[i*2+1]] : NULL;
+	}
+}
+
+static void nvg__clearFrame(NVGframe* frame)
+{
+	frame->ncalls = 0;
+	frame->ncommands = 0;
+	nvg__clearPathBuffer(&frame->buffer);
+}
+
+static void nvg__deleteFrameBuffers(NVGframe* frame)
+{
+	if (frame->calls != NULL) free(frame->calls);
+	if (frame->commands != NULL) free(frame->commands);
+	nvg__deletePathBuffer(&frame->buffer);
+	memset(frame, 0, sizeof(NVGframe));
+}
+
+static void nvg__deleteJobs(NVGcontext* ctx)
+{
+	int i;
+	for (i = 0; i < ctx->cjobs; i++) {
+		nvg__deletePathBuffer(&ctx->jobs[i].output);
+		nvg__deletePathCache(ctx->jobs[i].ctx->cache);
+		free(ctx->jobs[i].ctx);
+	}
+	if (ctx->jobs != NULL) free(ctx->jobs);
+	ctx->jobs = NULL;
+	ctx->cjobs = 0;
+}
+
+// Returns the number of available jobs, which can be less than njobs if out of memory
+static int nvg__allocJobs(NVGcontext* ctx, int njobs)
+{
+	NVGtessJob* jobs;
+
+	if (njobs <= ctx->cjobs)
+		return njobs;
+
+	jobs = (NVGtessJob*)realloc(ctx->jobs, sizeof(NVGtessJob)*njobs);
+	if (jobs == NULL) return ctx->cjobs;
+	ctx->jobs = jobs;
+
+	while (ctx->cjobs < njobs) {
+		NVGtessJob* job = &ctx->jobs[ctx->cjobs];
+		memset(job, 0, sizeof(NVGtessJob));
+
+		job->ctx = (NVGcontext*)malloc(sizeof(NVGcontext));
+		if (job->ctx == NULL) break;
+		memset(job->ctx, 0, sizeof(NVGcontext));
+
+		job->ctx->cache = nvg__allocPathCache();
+		if (job->ctx->cache == NULL) {
+			free(job->ctx);
+			break;
+		}
+
+		ctx->cjobs++;
+	}
+
+	return ctx->cjobs;
+}
+
 static void nvg__setDevicePixelRatio(NVGcontext* ctx, float ratio)
 {
 	ctx->tessTol = 0.25f / ratio;
@@ -303,6 +514,8 @@ NVGcontext* nvgCreateInternal(NVGparams* params)
 	ctx->cache = nvg__allocPathCache();
 	if (ctx->cache == NULL) goto error;
 
+	ctx->pathCommands = -1;
+
 	nvgSave(ctx);
 	nvgReset(ctx);
 
@@ -340,12 +553,19 @@ NVGparams* nvgInternalParams(NVGcontext* ctx)
     return &ctx->params;
 }
 
+int nvgInternalFontImage(NVGcontext* ctx)
+{
+	return ctx->fontImages[ctx->fontImageIdx];
+}
+
 void nvgDeleteInternal(NVGcontext* ctx)
 {
 	int i;
 	if (ctx == NULL) return;
 	if (ctx->commands != NULL) free(ctx->commands);
 	if (ctx->cache != NULL) nvg__deletePathCache(ctx->cache);
+	nvg__deleteFrameBuffers(&ctx->frame);
+	nvg__deleteJobs(ctx);
 
 	if (ctx->fs)
 		fonsDeleteInternal(ctx->fs);
@@ -363,12 +583,19 @@ void nvgDeleteInternal(NVGcontext* ctx)
 	free(ctx);
 }
 
+static void nvg__compactFontImages(NVGcontext* ctx);
+
 void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float devicePixelRatio)
 {
 /*	printf("Tris: draws:%d  fill:%d  stroke:%d  text:%d  TOT:%d\n",
 		ctx->drawCallCount, ctx->fillTriCount, ctx->strokeTriCount, ctx->textTriCount,
 		ctx->fillTriCount+ctx->strokeTriCount+ctx->textTriCount);*/
 
+	if (ctx->compactFontImages) {
+		nvg__compactFontImages(ctx);
+		ctx->compactFontImages = 0;
+	}
+
 	ctx->nstates = 0;
 	nvgSave(ctx);
 	nvgReset(ctx);
@@ -377,6 +604,14 @@ void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float
 
 	ctx->params.renderViewport(ctx->params.userPtr, windowWidth, windowHeight, devicePixelRatio);
 
+	nvg__clearFrame(&ctx->frame);
+	ctx->frame.width = windowWidth;
+	ctx->frame.height = windowHeight;
+	ctx->frame.devicePxRatio = devicePixelRatio;
+	ctx->frame.tessTol = ctx->tessTol;
+	ctx->frame.distTol = ctx->distTol;
+	ctx->pathCommands = -1;
+
 	ctx->drawCallCount = 0;
 	ctx->fillTriCount = 0;
 	ctx->strokeTriCount = 0;
@@ -385,12 +620,25 @@ void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float
 
 void nvgCancelFrame(NVGcontext* ctx)
 {
+	nvg__clearFrame(&ctx->frame);
+	ctx->pathCommands = -1;
+
 	ctx->params.renderCancel(ctx->params.userPtr);
 }
 
+static void nvg__submitCalls(NVGcontext* ctx, NVGframe* frame, const NVGparams* params, NVGcontext* stats);
+
 void nvgEndFrame(NVGcontext* ctx)
 {
+	nvg__submitCalls(ctx, &ctx->frame, &ctx->params, ctx);
+	ctx->pathCommands = -1;
+
 	ctx->params.renderFlush(ctx->params.userPtr);
+	nvg__compactFontImages(ctx);
+}
+
+static void nvg__compactFontImages(NVGcontext* ctx)
+{
 	if (ctx->fontImageIdx != 0) {
 		int fontImage = ctx->fontImages[ctx->fontImageIdx];
 		int i, j, iw, ih;
@@ -1021,6 +1269,18 @@ void nvgResetScissor(NVGcontext* ctx)
 	state->scissor.extent[1] = -1.0f;
 }
 
+void nvgCurrentScissor(NVGcontext* ctx, NVGscissor* scissor)
+{
+	NVGstate* state = nvg__getState(ctx);
+	*scissor = state->scissor;
+}
+
+void nvgRestoreScissor(NVGcontext* ctx, const NVGscissor* scissor)
+{
+	NVGstate* state = nvg__getState(ctx);
+	state->scissor = *scissor;
+}
+
 // Global composite operation.
 void nvgGlobalCompositeOperation(NVGcontext* ctx, int op)
 {
@@ -1966,6 +2226,7 @@ static int nvg__expandFill(NVGcontext* ctx, float w, int lineJoin, float miterLi
 void nvgBeginPath(NVGcontext* ctx)
 {
 	ctx->ncommands = 0;
+	ctx->pathCommands = -1;
 	nvg__clearPathCache(ctx);
 }
 
@@ -2216,6 +2477,333 @@ void nvgDebugDumpPathCache(NVGcontext* ctx)
 	}
 }
 
+// Deferred rendering
+static NVGdeferredCall* nvg__allocCall(NVGcontext* ctx, int type, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe)
+{
+	NVGframe* frame = &ctx->frame;
+	NVGdeferredCall* call;
+
+	if (frame->ncalls+1 > frame->ccalls) {
+		NVGdeferredCall* calls;
+		int ccalls = frame->ncalls+1 + frame->ccalls/2;
+		calls = (NVGdeferredCall*)realloc(frame->calls, sizeof(NVGdeferredCall)*ccalls);
+		if (calls == NULL) return NULL;
+		frame->calls = calls;
+		frame->ccalls = ccalls;
+	}
+
+	call = &frame->calls[frame->ncalls++];
+	memset(call, 0, sizeof(NVGdeferredCall));
+	call->type = type;
+	call->paint = *paint;
+	call->compositeOperation = compositeOperation;
+	call->scissor = *scissor;
+	call->fringe = fringe;
+	call->path0 = -1;
+
+	return call;
+}
+
+// Records the current path, to be tessellated by nvg__submitCalls()
+static void nvg__deferPath(NVGcontext* ctx, int type, NVGpaint* paint, float strokeWidth)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGframe* frame = &ctx->frame;
+	NVGdeferredCall* call;
+
+	// Like the path cache, the commands are kept until the next nvgBeginPath()
+	if (ctx->pathCommands < 0) {
+		if (frame->ncommands+ctx->ncommands > frame->ccommands) {
+			float* commands;
+			int ccommands = frame->ncommands+ctx->ncommands + frame->ccommands/2;
+			commands = (float*)realloc(frame->commands, sizeof(float)*ccommands);
+			if (commands == NULL) return;
+			frame->commands = commands;
+			frame->ccommands = ccommands;
+		}
+		memcpy(&frame->commands[frame->ncommands], ctx->commands, sizeof(float)*ctx->ncommands);
+		ctx->pathCommands = frame->ncommands;
+		ctx->pathNCommands = ctx->ncommands;
+		frame->ncommands += ctx->ncommands;
+	}
+
+	call = nvg__allocCall(ctx, type, paint, state->compositeOperation, &state->scissor, ctx->fringeWidth);
+	if (call == NULL) return;
+
+	call->command0 = ctx->pathCommands;
+	call->ncommands = ctx->pathNCommands;
+	call->strokeWidth = strokeWidth;
+	call->antialias = ctx->params.edgeAntiAlias && state->shapeAntiAlias;
+	call->lineCap = state->lineCap;
+	call->lineJoin = state->lineJoin;
+	call->miterLimit = state->miterLimit;
+}
+
+static void nvg__renderFill(NVGcontext* ctx, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, const float* bounds, const NVGpath* paths, int npaths)
+{
+	NVGdeferredCall* call;
+
+	if (ctx->dispatch == NULL) {
+		ctx->params.renderFill(ctx->params.userPtr, paint, compositeOperation, scissor, fringe, bounds, paths, npaths);
+		return;
+	}
+
+	call = nvg__allocCall(ctx, NVG_DEFERRED_PATHS_FILL, paint, compositeOperation, scissor, fringe);
+	if (call == NULL) return;
+
+	call->path0 = nvg__appendPaths(&ctx->frame.buffer, paths, npaths);
+	call->npaths = npaths;
+	memcpy(call->bounds, bounds, sizeof(float)*4);
+}
+
+static void nvg__renderStroke(NVGcontext* ctx, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe, float strokeWidth, const NVGpath* paths, int npaths)
+{
+	NVGdeferredCall* call;
+
+	if (ctx->dispatch == NULL) {
+		ctx->params.renderStroke(ctx->params.userPtr, paint, compositeOperation, scissor, fringe, strokeWidth, paths, npaths);
+		return;
+	}
+
+	call = nvg__allocCall(ctx, NVG_DEFERRED_PATHS_STROKE, paint, compositeOperation, scissor, fringe);
+	if (call == NULL) return;
+
+	call->path0 = nvg__appendPaths(&ctx->frame.buffer, paths, npaths);
+	call->npaths = npaths;
+	call->strokeWidth = strokeWidth;
+}
+
+static void nvg__renderTriangles(NVGcontext* ctx, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGvertex* verts, int nverts)
+{
+	NVGdeferredCall* call;
+
+	if (ctx->dispatch == NULL) {
+		ctx->params.renderTriangles(ctx->params.userPtr, paint, compositeOperation, scissor, verts, nverts);
+		return;
+	}
+
+	call = nvg__allocCall(ctx, NVG_DEFERRED_TRIANGLES, paint, compositeOperation, scissor, ctx->fringeWidth);
+	if (call == NULL) return;
+
+	call->vert0 = nvg__appendVerts(&ctx->frame.buffer, verts, nverts);
+	call->nverts = nverts;
+}
+
+static void nvg__renderShape(NVGcontext* ctx, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, const NVGshape* shape, const NVGvertex* verts, int nverts)
+{
+	NVGdeferredCall* call;
+
+	if (ctx->dispatch == NULL) {
+		ctx->params.renderShape(ctx->params.userPtr, paint, compositeOperation, scissor, shape, verts, nverts);
+		return;
+	}
+
+	call = nvg__allocCall(ctx, NVG_DEFERRED_SHAPE, paint, compositeOperation, scissor, ctx->fringeWidth);
+	if (call == NULL) return;
+
+	call->shape = *shape;
+	call->vert0 = nvg__appendVerts(&ctx->frame.buffer, verts, nverts);
+	call->nverts = nverts;
+}
+
+static int nvg__isTessCall(const NVGdeferredCall* call)
+{
+	return call->type == NVG_DEFERRED_FILL || call->type == NVG_DEFERRED_STROKE;
+}
+
+// Tessellation job arguments
+struct NVGsubmit {
+	NVGcontext* ctx;
+	NVGframe* frame;
+};
+typedef struct NVGsubmit NVGsubmit;
+
+// Tessellates the paths of a job, may run on any thread
+static void nvg__tessellate(void* jobPtr, int index)
+{
+	NVGsubmit* submit = (NVGsubmit*)jobPtr;
+	NVGframe* frame = submit->frame;
+	NVGtessJob* job = &submit->ctx->jobs[index];
+	NVGcontext* tc = job->ctx;
+	int i;
+
+	nvg__clearPathBuffer(&job->output);
+	tc->tessTol = frame->tessTol;
+	tc->distTol = frame->distTol;
+
+	for (i = job->first; i < job->last; i++) {
+		NVGdeferredCall* call = &frame->calls[i];
+		float fringe = call->antialias ? call->fringe : 0.0f;
+
+		if (!nvg__isTessCall(call))
+			continue;
+
+		tc->commands = &frame->commands[call->command0];
+		tc->ncommands = call->ncommands;
+		tc->fringeWidth = call->fringe;
+
+		nvg__clearPathCache(tc);
+		nvg__flattenPaths(tc);
+
+		if (call->type == NVG_DEFERRED_FILL)
+			nvg__expandFill(tc, fringe, NVG_MITER, 2.4f);
+		else
+			nvg__expandStroke(tc, call->strokeWidth*0.5f, fringe, call->lineCap, call->lineJoin, call->miterLimit);
+
+		call->path0 = nvg__appendPaths(&job->output, tc->cache->paths, tc->cache->npaths);
+		call->npaths = tc->cache->npaths;
+		memcpy(call->bounds, tc->cache->bounds, sizeof(float)*4);
+	}
+}
+
+// Tessellates the recorded paths and submits all the recorded calls to the renderer.
+// Only touches the jobs and the dispatcher of the context, counts triangles in stats if not NULL.
+static void nvg__submitCalls(NVGcontext* ctx, NVGframe* frame, const NVGparams* params, NVGcontext* stats)
+{
+	const NVGpath* paths;
+	NVGsubmit submit;
+	int i, j, ntess = 0, njobs, count = 0, perJob;
+
+	submit.ctx = ctx;
+	submit.frame = frame;
+
+	for (i = 0; i < frame->ncalls; i++)
+		if (nvg__isTessCall(&frame->calls[i]))
+			ntess++;
+
+	if (ntess > 0) {
+		// Split the calls in ranges with the same number of paths to tessellate
+		njobs = nvg__allocJobs(ctx, nvg__clampi(ntess / NVG_MIN_JOB_PATHS, 1, ctx->maxJobs));
+
+		if (njobs > 0) {
+			perJob = (ntess + njobs-1) / njobs;
+			j = 0;
+			ctx->jobs[0].first = 0;
+
+			for (i = 0; i < frame->ncalls; i++) {
+				if (!nvg__isTessCall(&frame->calls[i]))
+					continue;
+				if (count == perJob) {
+					ctx->jobs[j].last = i;
+					ctx->jobs[++j].first = i;
+					count = 0;
+				}
+				frame->calls[i].job = j;
+				count++;
+			}
+
+			ctx->jobs[j].last = frame->ncalls;
+			njobs = j+1;
+
+			if (njobs > 1)
+				ctx->dispatch(ctx->dispatchPtr, nvg__tessellate, &submit, njobs);
+			else
+				nvg__tessellate(&submit, 0);
+
+			for (j = 0; j < njobs; j++)
+				nvg__resolvePathBuffer(&ctx->jobs[j].output);
+		}
+	}
+
+	nvg__resolvePathBuffer(&frame->buffer);
+
+	// Submit everything in the recording order
+	for (i = 0; i < frame->ncalls; i++) {
+		NVGdeferredCall* call = &frame->calls[i];
+
+		switch (call->type) {
+		case NVG_DEFERRED_FILL:
+		case NVG_DEFERRED_STROKE:
+			if (call->path0 < 0)
+				break;
+			paths = &ctx->jobs[call->job].output.paths[call->path0];
+			if (call->type == NVG_DEFERRED_FILL) {
+				params->renderFill(params->userPtr, &call->paint, call->compositeOperation, &call->scissor, call->fringe,
+								   call->bounds, paths, call->npaths);
+				for (j = 0; stats != NULL && j < call->npaths; j++) {
+					stats->fillTriCount += paths[j].nfill-2;
+					stats->fillTriCount += paths[j].nstroke-2;
+					stats->drawCallCount += 2;
+				}
+			} else {
+				params->renderStroke(params->userPtr, &call->paint, call->compositeOperation, &call->scissor, call->fringe,
+									 call->strokeWidth, paths, call->npaths);
+				for (j = 0; stats != NULL && j < call->npaths; j++) {
+					stats->strokeTriCount += paths[j].nstroke-2;
+					stats->drawCallCount++;
+				}
+			}
+			break;
+		case NVG_DEFERRED_PATHS_FILL:
+			if (call->path0 >= 0)
+				params->renderFill(params->userPtr, &call->paint, call->compositeOperation, &call->scissor, call->fringe,
+								   call->bounds, &frame->buffer.paths[call->path0], call->npaths);
+			break;
+		case NVG_DEFERRED_PATHS_STROKE:
+			if (call->path0 >= 0)
+				params->renderStroke(params->userPtr, &call->paint, call->compositeOperation, &call->scissor, call->fringe,
+									 call->strokeWidth, &frame->buffer.paths[call->path0], call->npaths);
+			break;
+		case NVG_DEFERRED_TRIANGLES:
+			if (call->vert0 >= 0)
+				params->renderTriangles(params->userPtr, &call->paint, call->compositeOperation, &call->scissor,
+										&frame->buffer.verts[call->vert0], call->nverts);
+			break;
+		case NVG_DEFERRED_SHAPE:
+			if (call->vert0 >= 0)
+				params->renderShape(params->userPtr, &call->paint, call->compositeOperation, &call->scissor,
+									&call->shape, &frame->buffer.verts[call->vert0], call->nverts);
+			break;
+		}
+	}
+
+	nvg__clearFrame(frame);
+}
+
+void nvgSetDispatcher(NVGcontext* ctx, NVGdispatchFunction dispatch, void* userPtr, int maxJobs)
+{
+	ctx->dispatch = dispatch;
+	ctx->dispatchPtr = userPtr;
+	ctx->maxJobs = nvg__maxi(maxJobs, 1);
+}
+
+NVGframe* nvgCreateFrame(void)
+{
+	NVGframe* frame = (NVGframe*)malloc(sizeof(NVGframe));
+	if (frame == NULL) return NULL;
+	memset(frame, 0, sizeof(NVGframe));
+	return frame;
+}
+
+void nvgDeleteFrame(NVGframe* frame)
+{
+	if (frame == NULL) return;
+	nvg__deleteFrameBuffers(frame);
+	free(frame);
+}
+
+void nvgEndFrameDeferred(NVGcontext* ctx, NVGframe* frame)
+{
+	NVGframe recorded = ctx->frame;
+
+	// Keep recording in the buffers of the given frame
+	ctx->frame = *frame;
+	*frame = recorded;
+
+	nvg__clearFrame(&ctx->frame);
+	ctx->pathCommands = -1;
+
+	// The replaced font atlases are still used by the frame
+	ctx->compactFontImages = 1;
+}
+
+void nvgSubmitFrame(NVGcontext* ctx, NVGframe* frame, const NVGparams* params)
+{
+	params->renderViewport(params->userPtr, frame->width, frame->height, frame->devicePxRatio);
+	nvg__submitCalls(ctx, frame, params, NULL);
+	params->renderFlush(params->userPtr);
+}
+
 void nvgFill(NVGcontext* ctx)
 {
 	NVGstate* state = nvg__getState(ctx);
@@ -2223,16 +2811,21 @@ void nvgFill(NVGcontext* ctx)
 	NVGpaint fillPaint = state->fill;
 	int i;
 
+	// Apply global alpha
+	fillPaint.innerColor.a *= state->alpha;
+	fillPaint.outerColor.a *= state->alpha;
+
+	if (ctx->dispatch != NULL) {
+		nvg__deferPath(ctx, NVG_DEFERRED_FILL, &fillPaint, 0.0f);
+		return;
+	}
+
 	nvg__flattenPaths(ctx);
 	if (ctx->params.edgeAntiAlias && state->shapeAntiAlias)
 		nvg__expandFill(ctx, ctx->fringeWidth, NVG_MITER, 2.4f);
 	else
 		nvg__expandFill(ctx, 0.0f, NVG_MITER, 2.4f);
 
-	// Apply global alpha
-	fillPaint.innerColor.a *= state->alpha;
-	fillPaint.outerColor.a *= state->alpha;
-
 	ctx->params.renderFill(ctx->params.userPtr, &fillPaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
 						   ctx->cache->bounds, ctx->cache->paths, ctx->cache->npaths);
 
@@ -2268,6 +2861,11 @@ void nvgStroke(NVGcontext* ctx)
 	strokePaint.innerColor.a *= state->alpha;
 	strokePaint.outerColor.a *= state->alpha;
 
+	if (ctx->dispatch != NULL) {
+		nvg__deferPath(ctx, NVG_DEFERRED_STROKE, &strokePaint, strokeWidth);
+		return;
+	}
+
 	nvg__flattenPaths(ctx);
 
 	if (ctx->params.edgeAntiAlias && state->shapeAntiAlias)
@@ -2286,6 +2884,346 @@ void nvgStroke(NVGcontext* ctx)
 	}
 }
 
+// Geometry
+struct NVGgeometry {
+	int stroke;
+	float xform[4]; // scale and rotation the geometry was created with
+	float fringeWidth;
+	float strokeWidth;
+	float strokeAlpha; // coverage of strokes thinner than a pixel
+	float bounds[4];
+	NVGpath* paths;
+	int npaths;
+	NVGvertex* verts;
+	int nverts;
+};
+
+static NVGgeometry* nvg__createGeometry(NVGcontext* ctx, int stroke)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpathCache* cache = ctx->cache;
+	NVGgeometry* geometry;
+	NVGvertex* dst;
+	float ox = state->xform[4], oy = state->xform[5];
+	int i, j, nverts = 0;
+
+	for (i = 0; i < cache->npaths; i++)
+		nverts += cache->paths[i].nfill + cache->paths[i].nstroke;
+
+	// Paths and vertices are stored right after the geometry
+	geometry = (NVGgeometry*)malloc(sizeof(NVGgeometry) + sizeof(NVGpath)*cache->npaths + sizeof(NVGvertex)*nverts);
+	if (geometry == NULL) return NULL;
+	memset(geometry, 0, sizeof(NVGgeometry));
+
+	geometry->stroke = stroke;
+	memcpy(geometry->xform, state->xform, sizeof(float)*4);
+	geometry->fringeWidth = ctx->fringeWidth;
+	geometry->strokeAlpha = 1.0f;
+	geometry->paths = (NVGpath*)(geometry + 1);
+	geometry->npaths = cache->npaths;
+	geometry->verts = (NVGvertex*)(geometry->paths + cache->npaths);
+	geometry->nverts = nverts;
+
+	// Vertices are kept relative to the translation of the path
+	geometry->bounds[0] = cache->bounds[0] - ox;
+	geometry->bounds[1] = cache->bounds[1] - oy;
+	geometry->bounds[2] = cache->bounds[2] - ox;
+	geometry->bounds[3] = cache->bounds[3] - oy;
+
+	dst = geometry->verts;
+	for (i = 0; i < cache->npaths; i++) {
+		NVGpath* path = &geometry->paths[i];
+		*path = cache->paths[i];
+
+		if (path->nfill > 0) {
+			for (j = 0; j < path->nfill; j++)
+				nvg__vset(&dst[j], path->fill[j].x - ox, path->fill[j].y - oy, path->fill[j].u, path->fill[j].v);
+			path->fill = dst;
+			dst += path->nfill;
+		} else {
+			path->fill = NULL;
+		}
+
+		if (path->nstroke > 0) {
+			for (j = 0; j < path->nstroke; j++)
+				nvg__vset(&dst[j], path->stroke[j].x - ox, path->stroke[j].y - oy, path->stroke[j].u, path->stroke[j].v);
+			path->stroke = dst;
+			dst += path->nstroke;
+		} else {
+			path->stroke = NULL;
+		}
+	}
+
+	return geometry;
+}
+
+NVGgeometry* nvgCreateFillGeometry(NVGcontext* ctx)
+{
+	NVGstate* state = nvg__getState(ctx);
+
+	nvg__flattenPaths(ctx);
+	if (ctx->params.edgeAntiAlias && state->shapeAntiAlias)
+		nvg__expandFill(ctx, ctx->fringeWidth, NVG_MITER, 2.4f);
+	else
+		nvg__expandFill(ctx, 0.0f, NVG_MITER, 2.4f);
+
+	return nvg__createGeometry(ctx, 0);
+}
+
+NVGgeometry* nvgCreateStrokeGeometry(NVGcontext* ctx)
+{
+	NVGstate* state = nvg__getState(ctx);
+	float scale = nvg__getAverageScale(state->xform);
+	float strokeWidth = nvg__clampf(state->strokeWidth * scale, 0.0f, 200.0f);
+	float strokeAlpha = 1.0f;
+	NVGgeometry* geometry;
+
+	if (strokeWidth < ctx->fringeWidth) {
+		// See nvgStroke()
+		float alpha = nvg__clampf(strokeWidth / ctx->fringeWidth, 0.0f, 1.0f);
+		strokeAlpha = alpha*alpha;
+		strokeWidth = ctx->fringeWidth;
+	}
+
+	nvg__flattenPaths(ctx);
+
+	if (ctx->params.edgeAntiAlias && state->shapeAntiAlias)
+		nvg__expandStroke(ctx, strokeWidth*0.5f, ctx->fringeWidth, state->lineCap, state->lineJoin, state->miterLimit);
+	else
+		nvg__expandStroke(ctx, strokeWidth*0.5f, 0.0f, state->lineCap, state->lineJoin, state->miterLimit);
+
+	geometry = nvg__createGeometry(ctx, 1);
+	if (geometry == NULL) return NULL;
+
+	geometry->strokeWidth = strokeWidth;
+	geometry->strokeAlpha = strokeAlpha;
+
+	return geometry;
+}
+
+// Puts the vertices of the geometry, translated to (x,y), in the path cache.
+static int nvg__placeGeometry(NVGcontext* ctx, NVGgeometry* geometry, float x, float y)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpathCache* cache = ctx->cache;
+	NVGvertex* verts;
+	float ox, oy;
+	int i;
+
+	if (geometry->fringeWidth != ctx->fringeWidth)
+		return 0;
+	for (i = 0; i < 4; i++) {
+		if (nvg__absf(geometry->xform[i] - state->xform[i]) > 1e-5f)
+			return 0;
+	}
+
+	nvgTransformPoint(&ox, &oy, state->xform, x, y);
+
+	verts = nvg__allocTempVerts(ctx, geometry->nverts);
+	if (verts == NULL) return 0;
+
+	if (geometry->npaths > cache->cpaths) {
+		NVGpath* paths = (NVGpath*)realloc(cache->paths, sizeof(NVGpath)*geometry->npaths);
+		if (paths == NULL) return 0;
+		cache->paths = paths;
+		cache->cpaths = geometry->npaths;
+	}
+
+	for (i = 0; i < geometry->nverts; i++) {
+		NVGvertex* src = &geometry->verts[i];
+		nvg__vset(&verts[i], src->x + ox, src->y + oy, src->u, src->v);
+	}
+
+	for (i = 0; i < geometry->npaths; i++) {
+		NVGpath* path = &cache->paths[i];
+		*path = geometry->paths[i];
+		if (path->fill != NULL)
+			path->fill = verts + (path->fill - geometry->verts);
+		if (path->stroke != NULL)
+			path->stroke = verts + (path->stroke - geometry->verts);
+	}
+
+	// The path cache now holds the geometry, the current path
+	// will be flattened again if it is drawn after this
+	cache->npoints = 0;
+	cache->npaths = geometry->npaths;
+	cache->bounds[0] = geometry->bounds[0] + ox;
+	cache->bounds[1] = geometry->bounds[1] + oy;
+	cache->bounds[2] = geometry->bounds[2] + ox;
+	cache->bounds[3] = geometry->bounds[3] + oy;
+
+	return 1;
+}
+
+int nvgFillGeometry(NVGcontext* ctx, NVGgeometry* geometry, float x, float y)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint fillPaint = state->fill;
+	const NVGpath* path;
+	int i;
+
+	if (geometry == NULL || geometry->stroke || !nvg__placeGeometry(ctx, geometry, x, y))
+		return 0;
+
+	// Apply global alpha
+	fillPaint.innerColor.a *= state->alpha;
+	fillPaint.outerColor.a *= state->alpha;
+
+	nvg__renderFill(ctx, &fillPaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
+					ctx->cache->bounds, ctx->cache->paths, ctx->cache->npaths);
+
+	// Count triangles
+	for (i = 0; i < ctx->cache->npaths; i++) {
+		path = &ctx->cache->paths[i];
+		ctx->fillTriCount += path->nfill-2;
+		ctx->fillTriCount += path->nstroke-2;
+		ctx->drawCallCount += 2;
+	}
+
+	nvg__clearPathCache(ctx);
+
+	return 1;
+}
+
+int nvgStrokeGeometry(NVGcontext* ctx, NVGgeometry* geometry, float x, float y)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint strokePaint = state->stroke;
+	const NVGpath* path;
+	int i;
+
+	if (geometry == NULL || !geometry->stroke || !nvg__placeGeometry(ctx, geometry, x, y))
+		return 0;
+
+	strokePaint.innerColor.a *= geometry->strokeAlpha;
+	strokePaint.outerColor.a *= geometry->strokeAlpha;
+
+	// Apply global alpha
+	strokePaint.innerColor.a *= state->alpha;
+	strokePaint.outerColor.a *= state->alpha;
+
+	nvg__renderStroke(ctx, &strokePaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
+					  geometry->strokeWidth, ctx->cache->paths, ctx->cache->npaths);
+
+	// Count triangles
+	for (i = 0; i < ctx->cache->npaths; i++) {
+		path = &ctx->cache->paths[i];
+		ctx->strokeTriCount += path->nstroke-2;
+		ctx->drawCallCount++;
+	}
+
+	nvg__clearPathCache(ctx);
+
+	return 1;
+}
+
+void nvgDeleteGeometry(NVGgeometry* geometry)
+{
+	free(geometry);
+}
+
+// Shapes
+static void nvg__drawShape(NVGcontext* ctx, NVGpaint* paint, int type, float x, float y, float w, float h, float r, float qx, float qy, float qw, float qh)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGshape shape;
+	NVGvertex verts[6];
+	float corners[8];
+	static const int indices[6] = { 0, 2, 1, 0, 3, 2 }; // same winding as text quads
+	int i;
+
+	memset(&shape, 0, sizeof(shape));
+	nvgTransformTranslate(shape.xform, x + w*0.5f, y + h*0.5f);
+	nvgTransformMultiply(shape.xform, state->xform);
+	shape.extent[0] = w*0.5f;
+	shape.extent[1] = h*0.5f;
+	shape.radius = nvg__clampf(r, 0.0f, nvg__minf(w, h)*0.5f);
+	shape.antialias = ctx->fringeWidth / nvg__getAverageScale(state->xform);
+	shape.type = type;
+
+	if (type == NVG_SHAPE_STROKE) {
+		shape.strokeWidth = state->strokeWidth;
+		qx -= state->strokeWidth*0.5f;
+		qy -= state->strokeWidth*0.5f;
+		qw += state->strokeWidth;
+		qh += state->strokeWidth;
+	}
+
+	if (type != NVG_SHAPE_OUTSIDE) {
+		qx -= shape.antialias;
+		qy -= shape.antialias;
+		qw += shape.antialias*2;
+		qh += shape.antialias*2;
+	}
+
+	// Apply global alpha
+	paint->innerColor.a *= state->alpha;
+	paint->outerColor.a *= state->alpha;
+
+	nvgTransformPoint(&corners[0], &corners[1], state->xform, qx, qy);
+	nvgTransformPoint(&corners[2], &corners[3], state->xform, qx + qw, qy);
+	nvgTransformPoint(&corners[4], &corners[5], state->xform, qx + qw, qy + qh);
+	nvgTransformPoint(&corners[6], &corners[7], state->xform, qx, qy + qh);
+
+	for (i = 0; i < 6; i++)
+		nvg__vset(&verts[i], corners[indices[i]*2], corners[indices[i]*2+1], 0.5f, 1.0f);
+
+	nvg__renderShape(ctx, paint, state->compositeOperation, &state->scissor, &shape, verts, 6);
+
+	ctx->fillTriCount += 2;
+	ctx->drawCallCount++;
+}
+
+void nvgFillRoundedRect(NVGcontext* ctx, float x, float y, float w, float h, float r)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint paint = state->fill;
+
+	nvgBeginPath(ctx);
+
+	if (ctx->params.renderShape == NULL || paint.image != 0) {
+		nvgRoundedRect(ctx, x, y, w, h, r);
+		nvgFill(ctx);
+		return;
+	}
+
+	nvg__drawShape(ctx, &paint, NVG_SHAPE_FILL, x, y, w, h, r, x, y, w, h);
+}
+
+void nvgStrokeRoundedRect(NVGcontext* ctx, float x, float y, float w, float h, float r)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint paint = state->stroke;
+
+	nvgBeginPath(ctx);
+
+	if (ctx->params.renderShape == NULL || paint.image != 0) {
+		nvgRoundedRect(ctx, x, y, w, h, r);
+		nvgStroke(ctx);
+		return;
+	}
+
+	nvg__drawShape(ctx, &paint, NVG_SHAPE_STROKE, x, y, w, h, r, x, y, w, h);
+}
+
+void nvgFillRoundedRectShadow(NVGcontext* ctx, float x, float y, float w, float h, float r, float sx, float sy, float sw, float sh)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint paint = state->fill;
+
+	nvgBeginPath(ctx);
+
+	if (ctx->params.renderShape == NULL || paint.image != 0) {
+		nvgRect(ctx, sx, sy, sw, sh);
+		nvgRoundedRect(ctx, x, y, w, h, r);
+		nvgPathWinding(ctx, NVG_HOLE);
+		nvgFill(ctx);
+		return;
+	}
+
+	nvg__drawShape(ctx, &paint, NVG_SHAPE_OUTSIDE, x, y, w, h, r, sx, sy, sw, sh);
+}
+
 // Add fonts
 int nvgCreateFont(NVGcontext* ctx, const char* name, const char* path)
 {
@@ -2404,7 +3342,7 @@ static int nvg__allocTextAtlas(NVGcontext* ctx)
 			iw *= 2;
 		if (iw > NVG_MAX_FONTIMAGE_SIZE || ih > NVG_MAX_FONTIMAGE_SIZE)
 			iw = ih = NVG_MAX_FONTIMAGE_SIZE;
-		ctx->fontImages[ctx->fontImageIdx+1] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, iw, ih, 0, NULL);
+		ctx->fontImages[ctx->fontImageIdx+1] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, iw, ih, ctx->fontImageFlags, NULL);
 	}
 	++ctx->fontImageIdx;
 	fonsResetAtlas(ctx->fs, iw, ih);
@@ -2419,11 +3357,17 @@ static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts)
 	// Render triangles.
 	paint.image = ctx->fontImages[ctx->fontImageIdx];
 
+	// Distance field glyphs are smoothed over one pixel, expressed in distance units
+	if (ctx->fontImageFlags & NVG_IMAGE_SDF) {
+		float size = state->fontSize * nvg__getFontScale(state) * ctx->devicePxRatio;
+		paint.feather = (float)FONS_SDF_ONEDGE / FONS_SDF_PADDING / 255.0f * FONS_SDF_SIZE / nvg__maxf(size, 1.0f);
+	}
+
 	// Apply global alpha
 	paint.innerColor.a *= state->alpha;
 	paint.outerColor.a *= state->alpha;
 
-	ctx->params.renderTriangles(ctx->params.userPtr, &paint, state->compositeOperation, &state->scissor, verts, nverts);
+	nvg__renderTriangles(ctx, &paint, state->compositeOperation, &state->scissor, verts, nverts);
 
 	ctx->drawCallCount++;
 	ctx->textTriCount += nverts/3;
@@ -2496,6 +3440,117 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	return iter.nextx / scale;
 }
 
+void nvgTextSDF(NVGcontext* ctx, int enabled)
+{
+	int i;
+	int flags = enabled ? NVG_IMAGE_SDF : 0;
+
+	if (flags == ctx->fontImageFlags)
+		return;
+
+	// Glyphs rasterized so far are of the wrong kind, start over with a new atlas
+	for (i = 0; i < NVG_MAX_FONTIMAGES; i++) {
+		if (ctx->fontImages[i] != 0) {
+			nvgDeleteImage(ctx, ctx->fontImages[i]);
+			ctx->fontImages[i] = 0;
+		}
+	}
+
+	ctx->fontImageFlags = flags;
+	ctx->fontImages[0] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, NVG_INIT_FONTIMAGE_SIZE, NVG_INIT_FONTIMAGE_SIZE, flags, NULL);
+	ctx->fontImageIdx = 0;
+
+	fonsSetSDF(ctx->fs, enabled);
+	fonsResetAtlas(ctx->fs, NVG_INIT_FONTIMAGE_SIZE, NVG_INIT_FONTIMAGE_SIZE);
+}
+
+int nvgTextIsSDF(NVGcontext* ctx)
+{
+	return (ctx->fontImageFlags & NVG_IMAGE_SDF) != 0;
+}
+
+int nvgTextPrewarm(NVGcontext* ctx, const char* string, const char* end)
+{
+	NVGstate* state = nvg__getState(ctx);
+	FONStextIter iter;
+	FONSquad q;
+	float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
+	int ret = 1;
+
+	if (end == NULL)
+		end = string + strlen(string);
+
+	if (state->fontId == FONS_INVALID) return 0;
+
+	fonsSetSize(ctx->fs, state->fontSize*scale);
+	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
+	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetAlign(ctx->fs, state->textAlign);
+	fonsSetFont(ctx->fs, state->fontId);
+
+	// Don't allocate a new atlas like nvgText does, since it would
+	// evict all glyphs, prewarmed ones included
+	fonsTextIterInit(ctx->fs, &iter, 0, 0, string, end, FONS_GLYPH_BITMAP_REQUIRED);
+	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
+		if (iter.prevGlyphIndex == -1) {
+			ret = 0;
+			break;
+		}
+	}
+
+	nvg__flushTextTexture(ctx);
+
+	return ret;
+}
+
+static void nvg__toFonsCachedGlyph(const NVGcachedGlyph* src, FONScachedGlyph* dst)
+{
+	dst->codepoint = src->codepoint;
+	dst->index = src->index;
+	dst->size = src->size;
+	dst->blur = src->blur;
+	dst->width = src->width;
+	dst->height = src->height;
+	dst->xadv = src->xadv;
+	dst->xoff = src->xoff;
+	dst->yoff = src->yoff;
+}
+
+int nvgFontGlyphCount(NVGcontext* ctx, int font)
+{
+	return fonsGetGlyphCount(ctx->fs, font);
+}
+
+int nvgExportFontGlyph(NVGcontext* ctx, int font, int index, NVGcachedGlyph* glyph, unsigned char* bitmap, int bitmapSize)
+{
+	FONScachedGlyph g;
+	if (!fonsExportGlyph(ctx->fs, font, index, &g, bitmap, bitmapSize))
+		return 0;
+
+	glyph->codepoint = g.codepoint;
+	glyph->index = g.index;
+	glyph->size = g.size;
+	glyph->blur = g.blur;
+	glyph->width = g.width;
+	glyph->height = g.height;
+	glyph->xadv = g.xadv;
+	glyph->xoff = g.xoff;
+	glyph->yoff = g.yoff;
+	return 1;
+}
+
+int nvgImportFontGlyph(NVGcontext* ctx, int font, const NVGcachedGlyph* glyph, const unsigned char* bitmap)
+{
+	FONScachedGlyph g;
+	nvg__toFonsCachedGlyph(glyph, &g);
+	return fonsImportGlyph(ctx->fs, font, &g, bitmap);
+}
+
+const unsigned char* nvgFontData(NVGcontext* ctx, int font, int* size)
+{
+	return fonsGetFontData(ctx->fs, font, size);
+}
+
 void nvgTextBox(NVGcontext* ctx, float x, float y, float breakRowWidth, const char* string, const char* end)
 {
 	NVGstate* state = nvg__getState(ctx);
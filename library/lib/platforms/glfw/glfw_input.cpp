@@ -108,6 +108,12 @@ void GLFWInputManager::updateControllerState(ControllerState* state)
         size_t brlsButton          = GLFW_BUTTONS_MAPPING[i];
         state->buttons[brlsButton] = (bool)glfwState.buttons[i];
     }
+
+    // Axes
+    state->axes[LEFT_X]  = glfwState.axes[GLFW_GAMEPAD_AXIS_LEFT_X];
+    state->axes[LEFT_Y]  = glfwState.axes[GLFW_GAMEPAD_AXIS_LEFT_Y];
+    state->axes[RIGHT_X] = glfwState.axes[GLFW_GAMEPAD_AXIS_RIGHT_X];
+    state->axes[RIGHT_Y] = glfwState.axes[GLFW_GAMEPAD_AXIS_RIGHT_Y];
 }
 
 };
@@ -41,7 +41,8 @@ static void glfwWindowFramebufferSizeCallback(GLFWwindow* window, int width, int
     if (!width || !height)
         return;
 
-    glViewport(0, 0, width, height);
+    GLFWVideoContext* videoContext = (GLFWVideoContext*)glfwGetWindowUserPointer(window);
+    videoContext->setFramebufferSize(width, height);
 
     Application::onWindowResized(width, height);
 }
@@ -75,6 +76,7 @@ GLFWVideoContext::GLFWVideoContext(std::string windowTitle, uint32_t windowWidth
     // Configure window
     glfwSetInputMode(window, GLFW_STICKY_KEYS, GLFW_TRUE);
     glfwMakeContextCurrent(window);
+    glfwSetWindowUserPointer(window, this);
     glfwSetFramebufferSizeCallback(window, glfwWindowFramebufferSizeCallback);
 
     // Load OpenGL routines using glad
@@ -86,7 +88,14 @@ GLFWVideoContext::GLFWVideoContext(std::string windowTitle, uint32_t windowWidth
     Logger::info("glfw: GL Version: {}", glGetString(GL_VERSION));
 
     // Initialize nanovg
-    this->nvgContext = nvgCreateGL3(NVG_STENCIL_STROKES | NVG_ANTIALIAS);
+    // Vertices and uniforms are streamed through ring buffers, persistently mapped if supported
+    int nvgFlags = NVG_STENCIL_STROKES | NVG_ANTIALIAS | NVG_STREAM_BUFFERS;
+    if (GLAD_GL_ARB_buffer_storage)
+        nvgFlags |= NVG_PERSISTENT_BUFFERS;
+
+    Logger::info("glfw: Using {} buffers streaming", GLAD_GL_ARB_buffer_storage ? "persistent" : "glBufferSubData");
+
+    this->nvgContext = nvgCreateGL3(nvgFlags);
     if (!this->nvgContext)
     {
         Logger::error("glfw: unable to init nanovg");
@@ -100,6 +109,7 @@ GLFWVideoContext::GLFWVideoContext(std::string windowTitle, uint32_t windowWidth
 
 void GLFWVideoContext::beginFrame()
 {
+    glViewport(0, 0, this->framebufferWidth, this->framebufferHeight);
 }
 
 void GLFWVideoContext::endFrame()
@@ -127,6 +137,17 @@ void GLFWVideoContext::resetState()
     glDisable(GL_STENCIL_TEST);
 }
 
+void GLFWVideoContext::makeCurrent(bool current)
+{
+    glfwMakeContextCurrent(current ? this->window : nullptr);
+}
+
+void GLFWVideoContext::setFramebufferSize(int width, int height)
+{
+    this->framebufferWidth  = width;
+    this->framebufferHeight = height;
+}
+
 GLFWVideoContext::~GLFWVideoContext()
 {
     if (this->nvgContext)
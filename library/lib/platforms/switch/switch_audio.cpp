@@ -102,7 +102,7 @@ bool SwitchAudioPlayer::load(enum Sound sound)
     if (soundName == "")
         return false; // unimplemented sound
 
-    Logger::debug("Loading sound {}: {}", sound, soundName);
+    BRLS_LOG_DEBUG("Loading sound {}: {}", sound, soundName);
 
     PLSR_RC rc = plsrPlayerLoadSoundByName(&this->qlaunchBfsar, soundName.c_str(), &this->sounds[sound]);
     if (PLSR_RC_FAILED(rc))
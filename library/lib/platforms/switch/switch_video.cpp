@@ -208,6 +208,8 @@ void SwitchVideoContext::beginFrame()
     // Poll the display resolution change event
     if (this->displayResolutionChangeEventReady && R_SUCCEEDED(eventWait(&this->defaultDisplayResolutionChangeEvent, 0)))
         this->resetFramebuffer();
+    else if (this->operationModeChanged.exchange(false))
+        this->resetFramebuffer();
 
     this->imageSlot = this->queue.acquireImage(this->swapchain);
 
@@ -251,7 +253,7 @@ void SwitchVideoContext::appletCallback(AppletHookType hookType)
 {
     // Only reset framebuffer if the display resolution change event isn't ready
     if (hookType == AppletHookType_OnOperationMode && !this->displayResolutionChangeEventReady)
-        resetFramebuffer();
+        this->operationModeChanged = true;
 }
 
 NVGcontext* SwitchVideoContext::getNVGContext()
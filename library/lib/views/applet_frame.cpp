@@ -98,7 +98,7 @@ const std::string appletFrameXML = R"xml(
 
 AppletFrame::AppletFrame()
 {
-    this->inflateFromXMLString(appletFrameXML);
+    this->inflateFromBXML(BXMLDocument::getCompiledString(appletFrameXML));
 
     this->registerStringXMLAttribute("title", [this](std::string value) {
         this->setTitle(value);
@@ -157,6 +157,15 @@ void AppletFrame::handleXMLElement(tinyxml2::XMLElement* element)
     this->setContentView(view);
 }
 
+void AppletFrame::handleBXMLElement(BXMLElement element)
+{
+    if (this->contentView)
+        fatal("brls:AppletFrame can only have one child XML element");
+
+    View* view = View::createFromBXMLElement(element);
+    this->setContentView(view);
+}
+
 View* AppletFrame::create()
 {
     return new AppletFrame();
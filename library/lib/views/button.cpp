@@ -50,7 +50,7 @@ const std::string buttonXML = R"xml(
 
 Button::Button()
 {
-    this->inflateFromXMLString(buttonXML);
+    this->inflateFromBXML(BXMLDocument::getCompiledString(buttonXML));
 
     this->forwardXMLAttribute("text", this->label);
     this->forwardXMLAttribute("singleLine", this->label);
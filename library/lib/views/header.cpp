@@ -58,7 +58,7 @@ const std::string headerXML = R"xml(
 
 Header::Header()
 {
-    this->inflateFromXMLString(headerXML);
+    this->inflateFromBXML(BXMLDocument::getCompiledString(headerXML));
 
     this->registerStringXMLAttribute("title", [this](std::string value) {
         this->setTitle(value);
@@ -146,10 +146,7 @@ void Image::draw(NVGcontext* vg, float x, float y, float width, float height, St
         return;
 
     if (this->scalingType == ImageScalingType::CROP)
-    {
-        nvgSave(vg);
-        nvgIntersectScissor(vg, x, y, width, height);
-    }
+        ctx->pushScissor(x, y, width, height);
 
     float coordX = x + this->imageX;
     float coordY = y + this->imageY;
@@ -163,7 +160,7 @@ void Image::draw(NVGcontext* vg, float x, float y, float width, float height, St
     nvgFill(vg);
 
     if (this->scalingType == ImageScalingType::CROP)
-        nvgRestore(vg);
+        ctx->popScissor();
 }
 
 void Image::onLayout()
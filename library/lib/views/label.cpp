@@ -395,8 +395,7 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
     // Animated text
     if (this->animating)
     {
-        nvgSave(vg);
-        nvgIntersectScissor(vg, x, y, width, height);
+        ctx->pushScissor(x, y, width, height);
 
         float baseX   = x - this->scrollingAnimation;
         float spacing = style["brls/label/scrolling_animation_spacing"];
@@ -406,7 +405,7 @@ void Label::draw(NVGcontext* vg, float x, float y, float width, float height, St
         if (this->scrollingAnimation > 0)
             nvgText(vg, baseX + this->requiredWidth + spacing, y + height / 2.0f, this->fullText.c_str(), nullptr);
 
-        nvgRestore(vg);
+        ctx->popScissor();
     }
     // Wrapped text
     else if (this->isWrapping)
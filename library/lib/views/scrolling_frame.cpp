@@ -40,16 +40,15 @@ void ScrollingFrame::draw(NVGcontext* vg, float x, float y, float width, float h
         this->updateScrollingOnNextFrame = false;
 
     // Enable scissoring
-    nvgSave(vg);
     float scrollingTop    = this->getScrollingAreaTopBoundary();
     float scrollingHeight = this->getScrollingAreaHeight();
-    nvgIntersectScissor(vg, x, scrollingTop, this->getWidth(), scrollingHeight);
+    ctx->pushScissor(x, scrollingTop, this->getWidth(), scrollingHeight);
 
     // Draw children
     Box::draw(vg, x, y, width, height, style, ctx);
 
     //Disable scissoring
-    nvgRestore(vg);
+    ctx->popScissor();
 }
 
 void ScrollingFrame::addView(View* view)
@@ -57,9 +56,13 @@ void ScrollingFrame::addView(View* view)
     this->setContentView(view);
 }
 
-void ScrollingFrame::removeView(View* view)
+void ScrollingFrame::removeView(View* view, bool free)
 {
-    this->setContentView(nullptr);
+    if (!this->contentView)
+        return;
+
+    Box::removeView(this->contentView, free);
+    this->contentView = nullptr;
 }
 
 void ScrollingFrame::setContentView(View* view)
@@ -154,6 +157,7 @@ void ScrollingFrame::startScrolling(bool animated, float newScroll)
     else
     {
         this->scrollY = newScroll;
+        this->scrollAnimationTick();
     }
 
     this->invalidate();
@@ -182,8 +186,9 @@ void ScrollingFrame::onChildFocusGained(View* directChild, View* focusedView)
 {
     this->childFocused = true;
 
-    // Start scrolling
-    this->updateScrolling(true);
+    // Start scrolling - unless the focus is following an analog scroll
+    if (!this->analogScrolling)
+        this->updateScrolling(true);
 
     Box::onChildFocusGained(directChild, focusedView);
 }
@@ -221,6 +226,84 @@ bool ScrollingFrame::updateScrolling(bool animated)
     return true;
 }
 
+void ScrollingFrame::scrollBy(float delta)
+{
+    float contentHeight   = this->getContentHeight();
+    float scrollingHeight = this->getScrollingAreaHeight();
+
+    if (!this->contentView || contentHeight <= scrollingHeight)
+        return;
+
+    float newScroll = this->scrollY * contentHeight + delta;
+
+    // Boundaries
+    if (newScroll > contentHeight - scrollingHeight)
+        newScroll = contentHeight - scrollingHeight;
+
+    if (newScroll < 0.0f)
+        newScroll = 0.0f;
+
+    this->startScrolling(false, newScroll / contentHeight);
+
+    if (this->childFocused)
+        this->keepFocusOnScreen();
+}
+
+View* ScrollingFrame::getNextFocusInContent(FocusDirection direction, View* currentView)
+{
+    View* nextFocus = nullptr;
+
+    // Same traversal as the application navigation, stopping at the content view
+    while (!nextFocus && currentView->hasParent() && currentView->getParent() != this)
+    {
+        nextFocus   = currentView->getParent()->getNextFocus(direction, currentView);
+        currentView = currentView->getParent();
+    }
+
+    return nextFocus;
+}
+
+void ScrollingFrame::keepFocusOnScreen()
+{
+    View* focusedView = Application::getCurrentFocus();
+
+    if (!focusedView)
+        return;
+
+    float top    = this->getScrollingAreaTopBoundary();
+    float bottom = top + this->getScrollingAreaHeight();
+
+    // Walk the focus down (or up) until it's back on screen
+    View* nextFocus = focusedView;
+
+    while (nextFocus->getY() < top)
+    {
+        View* candidate = this->getNextFocusInContent(FocusDirection::DOWN, nextFocus);
+
+        if (!candidate)
+            break;
+
+        nextFocus = candidate;
+    }
+
+    while (nextFocus->getY() + nextFocus->getHeight() > bottom)
+    {
+        View* candidate = this->getNextFocusInContent(FocusDirection::UP, nextFocus);
+
+        if (!candidate)
+            break;
+
+        nextFocus = candidate;
+    }
+
+    if (nextFocus == focusedView)
+        return;
+
+    this->analogScrolling = true;
+    Application::giveFocus(nextFocus);
+    this->analogScrolling = false;
+}
+
 #define NO_PADDING fatal("Padding is not supported by brls:ScrollingFrame, please set padding on the content view instead");
 
 void ScrollingFrame::setPadding(float top, float right, float bottom, float left)
@@ -58,7 +58,7 @@ const std::string sidebarItemXML = R"xml(
 SidebarItem::SidebarItem()
     : Box(Axis::ROW)
 {
-    this->inflateFromXMLString(sidebarItemXML);
+    this->inflateFromBXML(BXMLDocument::getCompiledString(sidebarItemXML));
 
     this->registerStringXMLAttribute("label", [this](std::string value) {
         this->setLabel(value);
@@ -16,10 +16,18 @@
     limitations under the License.
 */
 
+#include <algorithm>
 #include <borealis/core/logger.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/views/tab_frame.hpp>
 
+// Number of hidden tabs kept in memory by default
+#define TAB_CACHE_SIZE 3
+
+// Time without switching tabs before preloading the neighbours of the current one, in ms
+// Once started, one tab is preloaded per frame until the user switches tabs again
+#define TAB_PRELOAD_DELAY 100
+
 const std::string tabFrameContentXML = R"xml(
     <brls:Box
         width="auto"
@@ -42,37 +50,192 @@ namespace brls
 
 TabFrame::TabFrame()
 {
-    View* contentView = View::createFromXMLString(tabFrameContentXML);
+    View* contentView = View::createFromBXML(BXMLDocument::getCompiledString(tabFrameContentXML));
     this->setContentView(contentView);
+
+    this->setTabCacheSize(TAB_CACHE_SIZE);
+
+    this->preloadTimer.setEndCallback([this](bool finished) {
+        // Stopped by a tab switch or the destructor
+        if (!finished)
+            return;
+
+        // Keep going on the next frame if there are more tabs to preload
+        if (this->preloadNextTab())
+            this->preloadTimer.start(0);
+    });
+
+    // Register XML attributes
+    this->registerFloatXMLAttribute("tabCacheSize", [this](float value) {
+        if (value < 0)
+            fatal("Illegal value \"" + std::to_string(value) + "\" for \"" + this->describe() + "\" XML attribute \"tabCacheSize\"");
+
+        this->setTabCacheSize((unsigned)value);
+    });
+
+    this->registerBoolXMLAttribute("preloadTabs", [this](bool value) {
+        this->setTabPreloadingEnabled(value);
+    });
+}
+
+TabFrame::~TabFrame()
+{
+    this->preloadTimer.stop();
+
+    // Hidden tabs are not in the views tree
+    for (size_t index : this->cachedTabs)
+        delete this->tabs[index].view;
 }
 
 void TabFrame::addTab(std::string label, TabViewCreator creator)
 {
-    this->sidebar->addItem(label, [this, creator](brls::View* view) {
+    size_t index = this->tabs.size();
+    this->tabs.push_back(Tab { creator });
+
+    this->sidebar->addItem(label, [this, index](brls::View* view) {
         // Only trigger when the sidebar item gains focus
         if (!view->isFocused())
             return;
 
-        Box* contentView = (Box*)this->contentView;
+        this->showTab(index);
+    });
+}
+
+void TabFrame::showTab(size_t index)
+{
+    // Focus coming back to the sidebar
+    if (this->activeTab && this->activeTabIndex == index)
+        return;
 
-        // Remove the existing tab if it exists
-        if (this->activeTab)
+    Box* contentView = (Box*)this->contentView;
+
+    // Hide the existing tab if it exists
+    if (this->activeTab)
+    {
+        if (this->tabCacheSize > 0)
+        {
+            contentView->removeView(this->activeTab, false); // will call willDisappear
+            this->cacheTab(this->activeTabIndex, this->activeTab);
+        }
+        else
         {
             contentView->removeView(this->activeTab); // will call willDisappear and delete
-            this->activeTab = nullptr;
         }
 
-        // Add the new tab
-        View* newContent = creator();
+        this->activeTab = nullptr;
+    }
+
+    this->lastDirection  = index < this->activeTabIndex ? -1 : 1;
+    this->activeTabIndex = index;
 
-        if (!newContent)
-            return;
+    this->schedulePreload();
 
-        newContent->setGrow(1.0f);
-        contentView->addView(newContent); // addView calls willAppear
+    // Add the new tab
+    View* newContent = this->takeCachedTab(index);
 
-        this->activeTab = newContent;
-    });
+    if (!newContent)
+        newContent = this->tabs[index].creator();
+
+    if (!newContent)
+        return;
+
+    newContent->setGrow(1.0f);
+    contentView->addView(newContent); // addView calls willAppear
+
+    this->activeTab = newContent;
+}
+
+void TabFrame::cacheTab(size_t index, View* view)
+{
+    this->tabs[index].view = view;
+    this->cachedTabs.push_back(index);
+
+    this->trimTabCache();
+}
+
+View* TabFrame::takeCachedTab(size_t index)
+{
+    View* view = this->tabs[index].view;
+
+    if (!view)
+        return nullptr;
+
+    this->tabs[index].view = nullptr;
+    this->cachedTabs.erase(std::find(this->cachedTabs.begin(), this->cachedTabs.end(), index));
+
+    return view;
+}
+
+void TabFrame::trimTabCache()
+{
+    while (this->cachedTabs.size() > this->tabCacheSize)
+    {
+        size_t index = this->cachedTabs.front();
+        this->cachedTabs.erase(this->cachedTabs.begin());
+
+        delete this->tabs[index].view;
+        this->tabs[index].view = nullptr;
+    }
+}
+
+void TabFrame::setTabCacheSize(unsigned size)
+{
+    this->tabCacheSize = size;
+    this->trimTabCache();
+}
+
+void TabFrame::setTabPreloadingEnabled(bool enabled)
+{
+    this->tabPreloadingEnabled = enabled;
+
+    if (!enabled)
+        this->preloadTimer.stop();
+}
+
+void TabFrame::schedulePreload()
+{
+    if (!this->tabPreloadingEnabled || this->tabCacheSize == 0)
+        return;
+
+    // Wait for the user to stop switching tabs
+    this->preloadTimer.stop();
+    this->preloadTimer.start(TAB_PRELOAD_DELAY);
+}
+
+bool TabFrame::preloadNextTab()
+{
+    // Neighbours of the active tab, closest first, in the direction of the last switch first.
+    // Only as many as the cache can hold, so that preloading doesn't evict preloaded tabs.
+    size_t candidates = 0;
+
+    for (size_t distance = 1; distance < this->tabs.size() && candidates < this->tabCacheSize; distance++)
+    {
+        for (int direction : { this->lastDirection, -this->lastDirection })
+        {
+            long candidate = (long)this->activeTabIndex + direction * (long)distance;
+
+            if (candidate < 0 || candidate >= (long)this->tabs.size() || candidates >= this->tabCacheSize)
+                continue;
+
+            candidates++;
+
+            Tab& tab = this->tabs[candidate];
+
+            if (tab.view)
+                continue;
+
+            View* view = tab.creator();
+
+            // Empty tab, nothing to keep
+            if (!view)
+                continue;
+
+            this->cacheTab(candidate, view);
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void TabFrame::addSeparator()
@@ -119,6 +282,45 @@ void TabFrame::handleXMLElement(tinyxml2::XMLElement* element)
     }
 }
 
+void TabFrame::handleBXMLElement(BXMLElement element)
+{
+    std::string name = std::string(element.getName());
+
+    if (name == "brls:Tab")
+    {
+        const BXMLAttribute* labelAttribute = element.findAttribute("label");
+
+        if (!labelAttribute)
+            fatal("\"label\" attribute missing from \"" + name + "\" tab");
+
+        std::string label = View::getStringXMLAttributeValue(std::string(labelAttribute->value.raw));
+
+        BXMLElement viewElement = element.getFirstChild();
+
+        if (viewElement.isValid())
+        {
+            this->addTab(label, [viewElement] {
+                return View::createFromBXMLElement(viewElement);
+            });
+
+            if (viewElement.getNextSibling().isValid())
+                fatal("\"brls:Tab\" can only contain one child element");
+        }
+        else
+        {
+            this->addTab(label, [] { return nullptr; });
+        }
+    }
+    else if (name == "brls:Separator")
+    {
+        this->addSeparator();
+    }
+    else
+    {
+        fatal("Unknown child element \"" + name + "\" for \"brls:Tab\"");
+    }
+}
+
 View* TabFrame::create()
 {
     return new TabFrame();
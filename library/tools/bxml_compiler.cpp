@@ -0,0 +1,96 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Compiles XML layouts into ".bxml" files next to them, see brls::BXMLDocument
+// Usage: bxml_compiler <xml file or folder>...
+// Folders are compiled recursively
+
+#include <stdio.h>
+
+#include <borealis/core/bxml.hpp>
+#include <filesystem>
+
+static bool compileFile(std::string path)
+{
+    tinyxml2::XMLDocument xmlDocument;
+    tinyxml2::XMLError xmlError = xmlDocument.LoadFile(path.c_str());
+
+    if (xmlError != tinyxml2::XMLError::XML_SUCCESS)
+    {
+        fprintf(stderr, "%s: invalid XML: %s\n", path.c_str(), xmlDocument.ErrorStr());
+        return false;
+    }
+
+    std::string error;
+    brls::BXMLDocument* document = brls::BXMLDocument::compile(xmlDocument.RootElement(), &error);
+
+    if (!document)
+    {
+        fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+
+    std::string compiledPath = brls::BXMLDocument::getCompiledPath(path);
+    std::vector<char> data   = document->serialize();
+    delete document;
+
+    FILE* file = fopen(compiledPath.c_str(), "wb");
+
+    if (!file || fwrite(data.data(), 1, data.size(), file) != data.size())
+    {
+        fprintf(stderr, "%s: cannot write file\n", compiledPath.c_str());
+
+        if (file)
+            fclose(file);
+
+        return false;
+    }
+
+    fclose(file);
+
+    printf("%s: %zu bytes\n", compiledPath.c_str(), data.size());
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <xml file or folder>...\n", argv[0]);
+        return 1;
+    }
+
+    bool success = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::filesystem::path path = argv[i];
+
+        if (!std::filesystem::is_directory(path))
+        {
+            success &= compileFile(path.string());
+            continue;
+        }
+
+        for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".xml")
+                success &= compileFile(entry.path().string());
+        }
+    }
+
+    return success ? 0 : 1;
+}
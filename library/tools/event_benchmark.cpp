@@ -0,0 +1,95 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Measures the cost of brls::Event::fire() with 1, 10 and 100 subscribers,
+// against the previous implementation (std::list of callbacks, copied on every fire)
+// Usage: event_benchmark
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <borealis/core/event.hpp>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <vector>
+
+#define BENCHMARK_CALLS 1000000 // subscriber calls per round
+#define BENCHMARK_ROUNDS 21
+
+// Previous implementation
+template <typename... Ts>
+class ListEvent
+{
+  public:
+    typedef std::function<void(Ts...)> Callback;
+
+    void subscribe(Callback cb)
+    {
+        this->callbacks.push_back(cb);
+    }
+
+    bool fire(Ts... args)
+    {
+        for (Callback cb : this->callbacks)
+            cb(args...);
+
+        return !this->callbacks.empty();
+    }
+
+  private:
+    std::list<Callback> callbacks;
+};
+
+// Fires an event with the given amount of subscribers, prints the median time of a fire
+template <typename EventType>
+static void runBenchmark(const char* name, int subscribers)
+{
+    EventType event;
+    long counter = 0;
+
+    for (int i = 0; i < subscribers; i++)
+        event.subscribe([&counter, i](int value) { counter += value + i; });
+
+    int fires = BENCHMARK_CALLS / subscribers;
+    std::vector<double> times;
+
+    for (int round = 0; round < BENCHMARK_ROUNDS; round++)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < fires; i++)
+            event.fire(i);
+
+        times.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / fires);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    // The counter keeps the calls from being optimized out
+    printf("%-12s %3d subscribers: %8.1f ns per fire (%ld)\n", name, subscribers, times[times.size() / 2], counter);
+}
+
+int main()
+{
+    for (int subscribers : { 1, 10, 100 })
+    {
+        runBenchmark<brls::Event<int>>("Event", subscribers);
+        runBenchmark<ListEvent<int>>("ListEvent", subscribers);
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Measures the cost of 10,000 translated string lookups (brls::internal::getRawStr()),
+// against the previous implementation that resolved a JSON pointer on the locale DOMs
+// Usage: i18n_benchmark [locale]
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <borealis/core/assets.hpp>
+#include <borealis/core/i18n.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#define BENCHMARK_LOOKUPS 10000
+#define BENCHMARK_ROUNDS 50
+
+// A mix of hits in both locales and misses (untranslated strings)
+static const std::vector<std::string> benchmarkStrings = {
+    "brls/hints/ok",
+    "brls/hints/back",
+    "brls/hints/exit",
+    "brls/crash_frame/button",
+    "brls/loading_activity/text",
+    "demo/title",
+    "demo/welcome",
+    "demo/tabs/components",
+    "demo/tabs/layout",
+    "demo/components/buttons_header",
+    "demo/components/labels_header",
+    "demo/missing/string",
+    "brls/hints/missing",
+};
+
+// Previous implementation: one DOM per locale, keyed by file name
+static nlohmann::json loadLocaleDOM(std::string locale)
+{
+    nlohmann::json dom = nlohmann::json::object();
+
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(BRLS_ASSET("i18n/" + locale)))
+    {
+        std::string name = entry.path().filename().string();
+        if (entry.is_directory() || entry.path().extension() != ".json")
+            continue;
+
+        std::ifstream stream(entry.path());
+        stream >> dom[name.substr(0, name.length() - 5)];
+    }
+
+    return dom;
+}
+
+static std::string getRawStrDOM(const nlohmann::json& currentLocale, const nlohmann::json& defaultLocale, const std::string& stringName)
+{
+    nlohmann::json::json_pointer pointer("/" + stringName);
+
+    try
+    {
+        return currentLocale.at(pointer).get<std::string>();
+    }
+    catch (...)
+    {
+    }
+
+    try
+    {
+        return defaultLocale.at(pointer).get<std::string>();
+    }
+    catch (...)
+    {
+    }
+
+    return stringName;
+}
+
+// Runs BENCHMARK_LOOKUPS lookups BENCHMARK_ROUNDS times, prints the median time of a round
+template <typename Lookup>
+static void runBenchmark(const char* name, Lookup lookup)
+{
+    std::vector<double> times;
+    size_t length = 0;
+
+    for (int round = 0; round < BENCHMARK_ROUNDS; round++)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < BENCHMARK_LOOKUPS; i++)
+            length += lookup(benchmarkStrings[i % benchmarkStrings.size()]);
+
+        times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    double median = times[times.size() / 2];
+
+    // The total length keeps the lookups from being optimized out
+    printf("%-24s %10.1f us per %d lookups, %7.1f ns per lookup (%zu chars)\n", name, median, BENCHMARK_LOOKUPS, median * 1000.0 / BENCHMARK_LOOKUPS, length);
+}
+
+int main(int argc, char* argv[])
+{
+    std::string locale = argc > 1 ? argv[1] : brls::LOCALE_DEFAULT;
+
+    printf("Locale: %s\n", locale.c_str());
+
+    brls::loadTranslations(locale);
+    runBenchmark("string table", [](const std::string& stringName) {
+        return brls::internal::getRawStr(stringName).size();
+    });
+
+    nlohmann::json defaultLocale = loadLocaleDOM(brls::LOCALE_DEFAULT);
+    nlohmann::json currentLocale = locale != brls::LOCALE_DEFAULT ? loadLocaleDOM(locale) : nlohmann::json::object();
+    runBenchmark("JSON pointer (previous)", [&](const std::string& stringName) {
+        return getRawStrDOM(currentLocale, defaultLocale, stringName).size();
+    });
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+// Measures the CPU time nanovg takes to submit a draw-heavy frame to the GL driver
+// (nvgBeginFrame() to nvgEndFrame()), for each buffer streaming mode of the GL3 backend
+// The whole frame time (including the swap) is given too: waiting for the GPU to release
+// a ring buffer region is part of the submit time, while glBufferData hides it in the driver
+// Usage: nanovg_benchmark [frames]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#define NANOVG_GL3_IMPLEMENTATION
+#include <nanovg.h>
+#include <nanovg_gl.h>
+
+#define BENCHMARK_WIDTH 1280
+#define BENCHMARK_HEIGHT 720
+#define BENCHMARK_WARMUP_FRAMES 30
+#define BENCHMARK_FONT_PATH BRLS_RESOURCES "inter/Inter-Switch.ttf"
+
+// A list-heavy screen: rows with a highlight, an icon, two labels and a separator,
+// a sidebar with scissored items and a few strokes on top
+static void drawScreen(NVGcontext* vg, int font, int frame)
+{
+    // Sidebar
+    nvgBeginPath(vg);
+    nvgRect(vg, 0, 0, 400, BENCHMARK_HEIGHT);
+    nvgFillColor(vg, nvgRGB(50, 50, 50));
+    nvgFill(vg);
+
+    nvgSave(vg);
+    nvgScissor(vg, 0, 80, 400, BENCHMARK_HEIGHT - 160);
+    for (int i = 0; i < 20; i++)
+    {
+        float y = 80 + i * 60 - (frame % 60);
+
+        nvgBeginPath(vg);
+        nvgRoundedRect(vg, 20, y + 5, 360, 50, 4);
+        nvgFillColor(vg, i == 3 ? nvgRGB(0, 193, 255) : nvgRGB(60, 60, 60));
+        nvgFill(vg);
+
+        nvgFontFaceId(vg, font);
+        nvgFontSize(vg, 22);
+        nvgFillColor(vg, i == 3 ? nvgRGB(0, 0, 0) : nvgRGB(255, 255, 255));
+        nvgText(vg, 40, y + 38, "Sidebar item", nullptr);
+    }
+    nvgRestore(vg);
+
+    // List
+    for (int i = 0; i < 60; i++)
+    {
+        float x = 420 + (i % 2) * 420;
+        float y = 20 + (i / 2) * 23;
+
+        nvgBeginPath(vg);
+        nvgRect(vg, x, y, 400, 22);
+        nvgFillColor(vg, nvgRGBA(255, 255, 255, (i + frame) % 7 == 0 ? 40 : 10));
+        nvgFill(vg);
+
+        nvgBeginPath(vg);
+        nvgRoundedRect(vg, x + 4, y + 3, 16, 16, 3);
+        nvgFillColor(vg, nvgHSL((i * 37 % 360) / 360.0f, 0.6f, 0.5f));
+        nvgFill(vg);
+
+        nvgFontFaceId(vg, font);
+        nvgFontSize(vg, 16);
+        nvgFillColor(vg, nvgRGB(255, 255, 255));
+        nvgText(vg, x + 28, y + 16, "List item title", nullptr);
+        nvgFillColor(vg, nvgRGB(160, 160, 160));
+        nvgText(vg, x + 300, y + 16, "Value", nullptr);
+
+        nvgBeginPath(vg);
+        nvgRect(vg, x, y + 22, 400, 1);
+        nvgFillColor(vg, nvgRGB(80, 80, 80));
+        nvgFill(vg);
+    }
+
+    // Highlight
+    nvgBeginPath(vg);
+    nvgRoundedRect(vg, 420, 20 + (frame % 30) * 23, 400, 22, 4);
+    nvgStrokeColor(vg, nvgRGB(0, 255, 204));
+    nvgStrokeWidth(vg, 4);
+    nvgStroke(vg);
+
+    nvgBeginPath(vg);
+    nvgRect(vg, 0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+    nvgFillPaint(vg, nvgBoxGradient(vg, 0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 20, 40, nvgRGBA(0, 0, 0, 0), nvgRGBA(0, 0, 0, 60)));
+    nvgFill(vg);
+}
+
+static void runBenchmark(GLFWwindow* window, const char* name, int flags, int frames)
+{
+    NVGcontext* vg = nvgCreateGL3(flags);
+    if (!vg)
+    {
+        printf("%-28s unable to create the nanovg context\n", name);
+        return;
+    }
+
+    int font = nvgCreateFont(vg, "regular", BENCHMARK_FONT_PATH);
+    if (font < 0)
+        printf("Unable to load \"%s\", text is not drawn\n", BENCHMARK_FONT_PATH);
+
+    std::vector<double> submitTimes;
+    submitTimes.reserve(frames);
+    double totalFrameTime = 0;
+
+    for (int frame = 0; frame < BENCHMARK_WARMUP_FRAMES + frames; frame++)
+    {
+        glViewport(0, 0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+        auto start = std::chrono::steady_clock::now();
+
+        nvgBeginFrame(vg, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1.0f);
+        drawScreen(vg, font, frame);
+        nvgEndFrame(vg);
+
+        auto end = std::chrono::steady_clock::now();
+
+        glfwSwapBuffers(window);
+
+        if (frame >= BENCHMARK_WARMUP_FRAMES)
+        {
+            submitTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            totalFrameTime += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    nvgDeleteGL3(vg);
+
+    std::sort(submitTimes.begin(), submitTimes.end());
+    double totalSubmitTime = 0;
+    for (double time : submitTimes)
+        totalSubmitTime += time;
+
+    printf("%-28s submit: mean %8.1f us, median %8.1f us, p99 %8.1f us   frame: mean %8.1f us\n",
+        name,
+        totalSubmitTime / frames,
+        submitTimes[frames / 2],
+        submitTimes[frames * 99 / 100],
+        totalFrameTime / frames);
+}
+
+int main(int argc, char* argv[])
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 500;
+    if (frames <= 0)
+    {
+        printf("Usage: %s [frames]\n", argv[0]);
+        return 1;
+    }
+
+    if (!glfwInit())
+    {
+        printf("Unable to init glfw\n");
+        return 1;
+    }
+
+    // Same context as GLFWVideoContext, without vsync
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    GLFWwindow* window = glfwCreateWindow(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, "nanovg_benchmark", nullptr, nullptr);
+    if (!window)
+    {
+        printf("Unable to create the window\n");
+        glfwTerminate();
+        return 1;
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+    glfwSwapInterval(0);
+
+    printf("GL Renderer: %s\n", glGetString(GL_RENDERER));
+    printf("GL Version: %s\n", glGetString(GL_VERSION));
+    printf("CPU time per frame, %d frames:\n", frames);
+
+    int nvgFlags = NVG_STENCIL_STROKES | NVG_ANTIALIAS;
+
+    runBenchmark(window, "glBufferData", nvgFlags, frames);
+    runBenchmark(window, "stream (glBufferSubData)", nvgFlags | NVG_STREAM_BUFFERS, frames);
+
+    if (GLAD_GL_ARB_buffer_storage)
+        runBenchmark(window, "stream (persistent)", nvgFlags | NVG_STREAM_BUFFERS | NVG_PERSISTENT_BUFFERS, frames);
+    else
+        printf("%-28s not supported\n", "stream (persistent)");
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
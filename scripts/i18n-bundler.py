@@ -0,0 +1,151 @@
+"""
+Copyright 2021 natinusala
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+# Run with Python 3
+
+# Compiles the JSON files of the i18n folder into one binary bundle per locale,
+# loaded by brls::loadTranslations() instead of the JSON files when present.
+#
+# Every bundle contains all the strings of the default locale, replaced by
+# the ones of the bundle locale when translated, so that only one bundle
+# needs to be loaded at runtime.
+#
+# Format (little endian):
+#   header: magic "BRLSI18N", u32 version, u32 strings count
+#   index: for every string, sorted by hash then key:
+#       u32 FNV-1a hash of the key, u32 key offset, u32 key length, u32 value offset, u32 value length
+#   blob: UTF-8 keys and values, offsets are relative to its start
+
+import argparse
+import json
+import struct
+import sys
+from pathlib import Path
+
+# The default locale used by brls
+_DEFAULT_LOCALE = "en-US"
+
+_MAGIC = b"BRLSI18N"
+_VERSION = 1
+
+
+def _fnv1a(data: bytes) -> int:
+    """32 bits FNV-1a hash"""
+    h = 0x811C9DC5
+    for byte in data:
+        h = ((h ^ byte) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def _flatten(value, name: str, strings: dict):
+    """Flattens a JSON file into {"file/key/subkey" -> string}, like the runtime"""
+    if isinstance(value, str):
+        strings[name] = value
+    elif isinstance(value, dict):
+        for key in value:
+            _flatten(value[key], f"{name}/{key}", strings)
+    elif isinstance(value, list):
+        for index, item in enumerate(value):
+            _flatten(item, f"{name}/{index}", strings)
+
+
+def _load_locale(path: Path) -> dict:
+    """Loads and flattens all JSON files of a locale folder"""
+    strings = {}
+
+    if not path.is_dir():
+        return strings
+
+    for f in sorted(path.iterdir()):
+        if f.is_dir() or not f.name.endswith(".json"):
+            continue
+
+        with open(f, "r", encoding="utf-8") as jsonf:
+            _flatten(json.loads(jsonf.read()), f.name[:-5], strings)
+
+    return strings
+
+
+def _build_bundle(strings: dict) -> bytes:
+    """Serializes the given strings into a bundle"""
+    entries = sorted(
+        ((_fnv1a(key.encode("utf-8")), key.encode("utf-8"), value.encode("utf-8")) for key, value in strings.items()),
+        key=lambda entry: (entry[0], entry[1]),
+    )
+
+    index = bytearray()
+    blob = bytearray()
+
+    for h, key, value in entries:
+        key_offset = len(blob)
+        blob += key
+        value_offset = len(blob)
+        blob += value
+
+        index += struct.pack("<5I", h, key_offset, len(key), value_offset, len(value))
+
+    return _MAGIC + struct.pack("<2I", _VERSION, len(entries)) + bytes(index) + bytes(blob)
+
+
+if __name__ == "__main__":
+    # Arguments parsing
+    parser = argparse.ArgumentParser(description="Compile i18n strings into binary bundles")
+
+    parser.add_argument(
+        dest="path",
+        action="store",
+        help="The path to the i18n folder to compile",
+    )
+
+    parser.add_argument(
+        dest="output",
+        action="store",
+        help="The folder to write the <locale>.bin bundles into",
+    )
+
+    parser.add_argument(
+        "--locale",
+        dest="locales",
+        action="append",
+        help="Only compile the given locale, can be repeated (default: all locales)",
+    )
+
+    args = parser.parse_args()
+
+    path = Path(args.path)
+    output = Path(args.output)
+
+    if not path.is_dir():
+        print(f"Cannot compile i18n folder \"{path}\": not a folder")
+        sys.exit(1)
+
+    locales = args.locales or sorted(f.name for f in path.iterdir() if f.is_dir())
+
+    try:
+        default_strings = _load_locale(path / _DEFAULT_LOCALE)
+
+        output.mkdir(parents=True, exist_ok=True)
+
+        for locale in locales:
+            strings = dict(default_strings)
+            strings.update(_load_locale(path / locale))
+
+            with open(output / f"{locale}.bin", "wb") as bundle:
+                bundle.write(_build_bundle(strings))
+
+            print(f"{locale}: {len(strings)} strings")
+    except json.JSONDecodeError as e:
+        print(f"Cannot parse JSON file: {e}")
+        sys.exit(1)